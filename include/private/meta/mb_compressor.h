@@ -144,6 +144,14 @@ namespace lsp
 
             static constexpr size_t FFT_XOVER_RANK_MIN      = 12;
             static constexpr size_t FFT_XOVER_FREQ_MIN      = 44100;
+            static constexpr size_t FFT_XOVER_RANK_LOW      = 9;        // Lowest FFT rank of the crossover
+            static constexpr float  FFT_XOVER_SPLIT_REF     = 50.0f;    // Lowest split frequency which requires the full FFT rank [Hz]
+
+            static constexpr size_t OVERSAMPLING_MAX        = 4;        // Maximum oversampling factor of the detector
+            static constexpr size_t OVERSAMPLING_LATENCY    = 8;        // Maximum latency of the detector oversampling
+
+            static constexpr size_t CONTROL_PERIOD_MAX      = 32;       // Maximum control period of the gain computer [samples]
+            static constexpr size_t CONTROL_PERIOD_DIV      = 16;       // Minimum number of control periods per attack/release time
 
             enum mode_t
             {
@@ -164,6 +172,27 @@ namespace lsp
 
                 FB_DEFAULT              = FB_BT_3DB
             };
+
+            enum oversampling_t
+            {
+                OVS_NONE,
+                OVS_2X,
+                OVS_4X,
+
+                OVS_DEFAULT             = OVS_NONE
+            };
+
+            enum xover_latency_t
+            {
+                XLAT_FIXED,
+                XLAT_ADAPTIVE,
+                XLAT_4096,
+                XLAT_2048,
+                XLAT_1024,
+                XLAT_512,
+
+                XLAT_DEFAULT            = XLAT_FIXED
+            };
         };
 
         extern const meta::plugin_t mb_compressor_mono;
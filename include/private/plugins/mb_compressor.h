@@ -34,6 +34,7 @@
 #include <lsp-plug.in/dsp-units/util/Delay.h>
 #include <lsp-plug.in/dsp-units/util/FFTCrossover.h>
 #include <lsp-plug.in/dsp-units/util/MeterGraph.h>
+#include <lsp-plug.in/dsp-units/util/Oversampler.h>
 #include <lsp-plug.in/dsp-units/util/Sidechain.h>
 
 #include <private/meta/mb_compressor.h>
@@ -68,17 +69,41 @@ namespace lsp
                     SCT_INTERNAL,
                     SCT_EXTERNAL,
                     SCT_LINK,
+                    SCT_LINK_GAIN,
                 };
 
             protected:
+                enum sc_flags_t
+                {
+                    SCF_INTERNAL    = 1 << SCT_INTERNAL,
+                    SCF_EXTERNAL    = 1 << SCT_EXTERNAL,
+                    SCF_LINK        = 1 << SCT_LINK
+                };
+
                 enum sync_t
                 {
                     S_COMP_CURVE    = 1 << 0,
                     S_EQ_CURVE      = 1 << 1,
                     S_BAND_CURVE    = 1 << 2,
+                    S_AMP_CURVE     = 1 << 3,
 
-                    S_ALL           = S_COMP_CURVE | S_EQ_CURVE | S_BAND_CURVE
+                    S_ALL           = S_COMP_CURVE | S_EQ_CURVE | S_BAND_CURVE | S_AMP_CURVE
+                };
+
+            #ifdef MB_COMPRESSOR_PROFILING
+                enum profile_stage_t
+                {
+                    PS_PREMIX,                                  // Premix and input metering
+                    PS_PREPROCESS,                              // Pre-processing of input and sidechain streams
+                    PS_XOVER,                                   // Crossover and VCA apply
+                    PS_ANALYZER,                                // FFT analysis
+                    PS_METERING,                                // Dry/wet mix and output metering
+                    PS_BYPASS,                                  // Dry delay and bypass
+                    PS_MESH,                                    // Transfer function and mesh output
+
+                    PS_TOTAL
                 };
+            #endif /* MB_COMPRESSOR_PROFILING */
 
                 typedef struct premix_t
                 {
@@ -95,8 +120,6 @@ namespace lsp
                     float                  *vLink[2];           // Link buffer
 
                     float                  *vTmpIn[2];          // Replacement buffer for input
-                    float                  *vTmpLink[2];        // Replacement buffer for link
-                    float                  *vTmpSc[2];          // Replacement buffer for sidechain
 
                     plug::IPort            *pInToSc;            // Input -> Sidechain mix
                     plug::IPort            *pInToLink;          // Input -> Link mix
@@ -106,6 +129,22 @@ namespace lsp
                     plug::IPort            *pScToLink;          // Sidechain -> Link mix
                 } premix_t;
 
+                typedef struct mix_src_t
+                {
+                    const float            *vData[2];           // Source data for each channel
+                    float                   fGain;              // Mixing gain
+                } mix_src_t;
+
+            #ifdef MB_COMPRESSOR_PROFILING
+                typedef struct stage_time_t
+                {
+                    uint64_t                nMin;               // Minimum time spent by the stage
+                    uint64_t                nMax;               // Maximum time spent by the stage
+                    uint64_t                nSum;               // Overall time spent by the stage
+                    uint64_t                nCount;             // Number of measurements
+                } stage_time_t;
+            #endif /* MB_COMPRESSOR_PROFILING */
+
                 typedef struct comp_band_t
                 {
                     dspu::Sidechain         sSC;                // Sidechain module
@@ -115,6 +154,7 @@ namespace lsp
                     dspu::Filter            sRejFilter;         // Rejection filter for 'classic' mode
                     dspu::Filter            sAllFilter;         // All-pass filter for phase compensation
                     dspu::Delay             sScDelay;           // Sidechain delay for lookahead purpose
+                    dspu::Oversampler       sOver[2];           // Sidechain oversamplers for the detector
 
                     float                  *vBuffer;            // Crossover band data
                     float                  *vSc;                // Transfer function for sidechain
@@ -129,7 +169,19 @@ namespace lsp
                     float                   fFreqLCF;           // Cutoff frequency for high-pass filter
                     float                   fMakeup;            // Makeup gain
                     float                   fGainLevel;         // Gain adjustment level
+                    float                   fEnvLevel;          // Last envelope level
+                    float                   fCurveLevel;        // Last curve level
+                    float                   fReduction;         // Last gain reduction level
+                    float                   fCtlPeak;           // Peak detector level of the current control period
+                    float                   fCtlFrom;           // Gain at the start of the current control period
+                    float                   fCtlTo;             // Gain at the end of the current control period
                     uint32_t                nLookahead;         // Lookahead amount
+                    uint32_t                nCtlPeriod;         // Control period of the gain computer
+                    uint32_t                nCtlPhase;          // Number of samples passed in the current control period
+                #ifdef MB_COMPRESSOR_PROFILING
+                    stage_time_t            sScTime;            // Time spent by the sidechain processing
+                    stage_time_t            sCompTime;          // Time spent by the gain computer
+                #endif /* MB_COMPRESSOR_PROFILING */
 
                     bool                    bEnabled;           // Enabled flag
                     bool                    bCustHCF;           // Custom frequency for high-cut filter
@@ -139,6 +191,7 @@ namespace lsp
                     uint32_t                nScType;            // Sidechain type
                     uint32_t                nSync;              // Synchronize output data flags
                     uint32_t                nFilterID;          // Identifier of the filter
+                    comp_band_t            *pDetector;          // Band that computes VCA for the link group (self if not linked)
 
                     plug::IPort            *pScType;            // Sidechain type
                     plug::IPort            *pScSource;          // Sidechain source
@@ -198,18 +251,27 @@ namespace lsp
                     split_t                 vSplit[meta::mb_compressor_metadata::BANDS_MAX-1];   // Split bands
                     comp_band_t            *vPlan[meta::mb_compressor_metadata::BANDS_MAX];      // Execution plan (band indexes)
                     size_t                  nPlanSize;              // Plan size
+                    size_t                  nXOverRank;             // Maximum FFT rank the crossover is allocated for
 
                     float                  *vIn;                // Input data buffer
+                    float                  *vInData;            // Input data buffer before pre-mixing
                     float                  *vOut;               // Output data buffer
                     float                  *vScIn;              // Sidechain data buffer (if present)
                     float                  *vShmIn;             // Shared memory link buffer (if present)
+                    float                  *vShmGainOut;        // Shared memory gain link send buffer (if present)
+                    const float            *vShmGainIn;         // Shared memory gain link return buffer (if present)
+                    const float            *vShmProcIn;         // Processed shared memory link return buffer (if present)
+                    float                  *vShmProcOut;        // Processed shared memory link send buffer (if present)
 
-                    float                  *vInAnalyze;         // Input signal analysis
+                    const float            *vInAnalyze;         // Input signal analysis, may refer the input data directly
+                    float                  *vAnBuffer;          // Buffer for input signal analysis
                     float                  *vInBuffer;          // Input buffer
+                    const float            *vInDelayed;         // Delayed input signal, may refer the analyzed input directly
                     float                  *vBuffer;            // Common data processing buffer
                     float                  *vScBuffer;          // Sidechain buffer
                     float                  *vExtScBuffer;       // External sidechain buffer
                     float                  *vShmBuffer;         // Shared memory link buffer
+                    const float            *vShmLink;           // Envelope-boosted link, may refer the processed link return directly
                     float                  *vTr;                // Transfer function
                     float                  *vTrMem;             // Transfer buffer (memory)
 
@@ -217,11 +279,17 @@ namespace lsp
                     size_t                  nAnOutChannel;      // Analyzer channel used for output signal analysis
                     bool                    bInFft;             // Input signal FFT enabled
                     bool                    bOutFft;            // Output signal FFT enabled
+                    bool                    bXOver;             // FFT crossover has processed the previous block
+                    uint32_t                nSync;              // Synchronization flags
 
                     plug::IPort            *pIn;                // Input
                     plug::IPort            *pOut;               // Output
                     plug::IPort            *pScIn;              // Sidechain
                     plug::IPort            *pShmIn;             // Shared memory link input
+                    plug::IPort            *pShmGainOut;        // Shared memory gain link output
+                    plug::IPort            *pShmGainIn;         // Shared memory gain link input
+                    plug::IPort            *pShmProcOut;        // Processed shared memory link output
+                    plug::IPort            *pShmProcIn;         // Processed shared memory link input
                     plug::IPort            *pFftIn;             // Pre-processing FFT analysis data
                     plug::IPort            *pFftInSw;           // Pre-processing FFT analysis control port
                     plug::IPort            *pFftOut;            // Post-processing FFT analysis data
@@ -231,17 +299,27 @@ namespace lsp
                     plug::IPort            *pOutLvl;            // Output level meter
                 } channel_t;
 
+                typedef void (mb_compressor::*apply_vca_t)(size_t count);
+
             protected:
                 dspu::Analyzer          sAnalyzer;              // Analyzer
                 dspu::DynamicFilters    sFilters;               // Dynamic filters for each band in 'modern' mode
                 dspu::Counter           sCounter;               // Sync counter
                 uint32_t                nMode;                  // Compressor mode
+                uint32_t                nChannels;              // Number of channels
                 bool                    bSidechain;             // External side chain
                 bool                    bEnvUpdate;             // Envelope filter update
-                bool                    bUseShmLink;            // Shared memory link is in use
+                uint32_t                nScSources;             // Sidechain sources used by active detectors
+                bool                    bLinkActive;            // Shared memory link is mixed and boosted locally
+                uint32_t                nGainLinkBand;          // Band which gain is sent to the gain link
                 xover_mode_t            enXOver;                // Crossover mode
+                apply_vca_t             pApplyVCA;              // VCA apply routine for the crossover mode
                 bool                    bStereoSplit;           // Stereo split mode
+                bool                    bSingleBand;            // All channels have single band, crossover is not needed
+                bool                    bAdaptiveRate;          // Adaptive control rate of the gain computer
+                uint32_t                nXOverLatency;          // Crossover latency mode: fixed FFT rank or adaptive with a cap
                 uint32_t                nEnvBoost;              // Envelope boost
+                uint32_t                nOversampling;          // Detector oversampling factor
                 channel_t              *vChannels;              // Compressor channels
                 float                   fInGain;                // Input gain
                 float                   fDryGain;               // Dry gain
@@ -249,9 +327,12 @@ namespace lsp
                 float                   fZoom;                  // Zoom
                 uint8_t                *pData;                  // Aligned data pointer
                 float                  *vSc[2];                 // Sidechain signal data
-                float                  *vAnalyze[4];            // Analysis buffer
+                const float            *vAnalyze[4];            // Analysis buffer
                 float                  *vBuffer;                // Temporary buffer
                 float                  *vEnv;                   // Compressor envelope buffer
+                float                  *vZero;                  // Buffer filled with zeros
+                float                  *vOvsSc[2];              // Oversampled sidechain signal
+                float                  *vOvsEnv;                // Oversampled sidechain detector output
                 float                  *vTr;                    // Transfer buffer
                 float                  *vPFc;                   // Pass filter characteristics buffer
                 float                  *vRFc;                   // Reject filter characteristics buffer
@@ -259,9 +340,17 @@ namespace lsp
                 float                  *vCurve;                 // Curve
                 uint32_t               *vIndexes;               // Analyzer FFT indexes
                 core::IDBuffer         *pIDisplay;              // Inline display buffer
+                uint32_t               *vIDisplayIdx;           // Mesh point index for each pixel of the inline display
+                uint32_t                nIDisplayWidth;         // Width of the inline display the horizontal axis is computed for
+                bool                    bIDisplayUpdate;        // Inline display needs to be redrawn
+                bool                    bIDisplayBypass;        // Bypass state shown by the inline display
 
                 premix_t                sPremix;                // Premix
+            #ifdef MB_COMPRESSOR_PROFILING
+                stage_time_t            vStageTime[PS_TOTAL];   // Time spent by each processing stage
+            #endif /* MB_COMPRESSOR_PROFILING */
 
+                plug::IPort            *pGainLinkBand;          // Band which gain is sent to the gain link
                 plug::IPort            *pBypass;                // Bypass port
                 plug::IPort            *pMode;                  // Global mode
                 plug::IPort            *pInGain;                // Input gain port
@@ -273,24 +362,45 @@ namespace lsp
                 plug::IPort            *pShiftGain;             // Shift gain port
                 plug::IPort            *pZoom;                  // Zoom port
                 plug::IPort            *pEnvBoost;              // Envelope adjust
+                plug::IPort            *pOversampling;          // Detector oversampling
+                plug::IPort            *pAdaptiveRate;          // Adaptive control rate
+                plug::IPort            *pXOverLatency;          // Crossover latency mode
                 plug::IPort            *pStereoSplit;           // Split left/right independently
 
             protected:
                 static bool compare_bands_for_sort(const comp_band_t *b1, const comp_band_t *b2);
                 static dspu::compressor_mode_t      decode_mode(int mode);
                 static dspu::sidechain_source_t     decode_sidechain_source(int source, bool split, size_t channel);
+                static dspu::over_mode_t            decode_oversampling(int mode);
                 static size_t                       select_fft_rank(size_t sample_rate);
+                static size_t                       select_xover_rank(size_t sample_rate, float split, size_t mode);
                 static void                         process_band(void *object, void *subject, size_t band, const float *data, size_t sample, size_t count);
+                static void                         update_delay(dspu::Delay *delay, size_t samples);
+                static size_t                       select_control_period(size_t sample_rate, float attack, float release);
+            #ifdef MB_COMPRESSOR_PROFILING
+                static uint64_t                     profile_clock();
+                static void                         reset_stage_time(stage_time_t *t);
+                static void                         commit_stage_time(stage_time_t *t, uint64_t start);
+                static void                         dump_stage_time(dspu::IStateDumper *v, const char *name, const stage_time_t *t);
+            #endif /* MB_COMPRESSOR_PROFILING */
 
             protected:
                 void                do_destroy();
                 void                preprocess_channel_input(size_t count);
                 void                update_premix();
+                void                resize_sc_delays();
                 void                premix_channel(uint32_t channel, size_t count);
                 uint32_t            decode_sidechain_type(uint32_t sc) const;
-                void                process_input_mono(float *out, const float *in, size_t count);
-                void                process_input_stereo(float *l_out, float *r_out, const float *l_in, const float *r_in, size_t count);
+                void                mix_input(const float **dst, float * const *buf, const mix_src_t *src, size_t n, size_t count);
                 const float        *select_buffer(const comp_band_t *band, const channel_t *channel);
+                const float        *delay_input(channel_t *c, float *dst, size_t count);
+                void                update_transfer_function(channel_t *c, const float *tr);
+                void                process_detector(comp_band_t *band, size_t count);
+                size_t              process_gain(comp_band_t *band, size_t count);
+                size_t              send_gain(const comp_band_t *band, size_t count);
+                void                apply_vca_classic(size_t count);
+                void                apply_vca_modern(size_t count);
+                void                apply_vca_linear_phase(size_t count);
 
             public:
                 explicit mb_compressor(const meta::plugin_t *metadata, bool sc, size_t mode);
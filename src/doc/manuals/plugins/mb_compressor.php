@@ -73,9 +73,12 @@
 	</li>
 	<li><b>Mode</b> - combo box that allows to switch between the following modes:</li>
 	<ul>
-		<li><b>Classic</b> - classic operating mode using IIR filters and allpass filters to compensate phase shifts.</li>
+		<li><b>Classic</b> - classic operating mode using IIR filters and allpass filters to compensate phase shifts.
+		The signal is split by a tree of Linkwitz-Riley filters, and each processed band passes the allpass filters
+		of the upper split points, so the bands sum up with coherent phase and no additional latency.</li>
 		<li><b>Modern</b> - modern operating mode using IIR shelving filters to adjust the gain of each frequency band.</li>
-		<li><b>Linear Phase</b> - linear phase operating mode using FFT transform (FIR filters) to split signal into multiple bands, introduces additional latency.</li>
+		<li><b>Linear Phase</b> - linear phase operating mode using FFT transform (FIR filters) to split signal into multiple bands, introduces additional latency.
+		The size of the FFT and the latency are selected by the <b>Latency</b> setting.</li>
 	</ul>
 	<li><b>SC Boost</b> - enables addidional boost of the sidechain signal:</li>
 	<ul>
@@ -85,7 +88,34 @@
 		<li><b>Brown BT</b> - a +6db/octave sidechain boost using bilinear-transformed shelving filter.</li>
 		<li><b>Brown MT</b> - a +6db/octave sidechain boost using matched-transformed shelving filter.</li>
 	</ul>
+	<li><b>Oversampling</b> - oversampling of the sidechain signal passed to the envelope detector, allows to catch inter-sample peaks
+	which can be missed at the original sample rate when short attack times are used. The audio signal is not oversampled:</li>
+	<ul>
+		<li><b>None</b> - the detector works at the original sample rate.</li>
+		<li><b>2x</b> - the detector works at the doubled sample rate, the Lanczos interpolation filter introduces additional latency of few samples.</li>
+		<li><b>4x</b> - the detector works at the quadrupled sample rate, the Lanczos interpolation filter introduces additional latency of few samples.</li>
+	</ul>
+	<li><b>Adaptive Rate</b> - allows the gain computer of each band to work at reduced control rate selected from the attack and release
+	times of the band. The gain between control points is linearly interpolated. Saves CPU for bands with slow attack and release.</li>
+	<li><b>Latency</b> - selects the FFT size of the linear phase crossover which defines its latency:</li>
+	<ul>
+		<li><b>Fixed</b> - the FFT size depends on the sample rate only, the latency does not change.</li>
+		<li><b>Adaptive</b> - the FFT size is selected by the lowest split frequency: each octave above 50 Hz halves the FFT size
+		and the latency. The latency of the plugin changes when the lowest split frequency is moved.</li>
+		<li><b>Max 4096</b>, <b>Max 2048</b>, <b>Max 1024</b>, <b>Max 512</b> - same as <b>Adaptive</b> but the FFT size never
+		exceeds the selected value. Lower values reduce the latency at the cost of the frequency resolution of the lowest splits.</li>
+	</ul>
 	<li><b>Link</b> - the name of shared memory link used to receive sidechain signal</li>
+	<li><b>Processed Link</b> - a pair of shared memory links for the envelope-boosted sidechain link signal. The first one receives
+	the signal already mixed and boosted by other instance, the detectors use it as is instead of mixing and boosting the link locally.
+	If nothing is received, the link is processed locally. The second one sends the envelope-boosted link signal to other instances.
+	While the signal is received, the link pre-mix settings (<b>In -> Link</b><?php if ($sc) { ?>, <b>SC -> Link</b><?php } ?>) and
+	the <b>SC Boost</b> of this instance are not applied to the link, the settings of the sending instance are used instead.</li>
+	<li><b>Gain link band</b> - the band which gain reduction is sent to the gain shared memory link.</li>
+	<li><b>Gain link</b> - a pair of shared memory links for the gain reduction of bands. The first one receives the gain reduction
+	used by bands with the <b>Link Gain</b> sidechain type. The second one sends the gain reduction of the selected band to other instances.
+	The makeup gain and muting of the band are not applied to the sent gain. The instance that receives the gain should have the
+	same latency as the sending one.</li>
 	<li><b>FFT<?= $sm ?> In</b> - enables FFT curve graph of input signal on the spectrum graph.</li>
 	<li><b>FFT<?= $sm ?> Out</b> - enables FFT curve graph of output signal on the spectrum graph.</li>
 	<?php if ($m == 's') { ?>
@@ -132,7 +162,8 @@
 		<li><b>On</b> - enables compressor assigned to the corresponding frequency band.</li>
 		<li><b>S</b> - turns on soloing mode to the selected band by applying -36 dB gain to non-soloing bands</li>
 		<li><b>M</b> - turns on muting mode to the selected band by applying -36 dB gain to it</li>
-		<li><b>Sidechain combo</b> - allows to select external sidechain inputs or shared memory audio stream</li>
+		<li><b>Sidechain combo</b> - allows to select external sidechain inputs or shared memory audio stream.
+		The <b>Link Gain</b> option makes the band apply the gain reduction received over the gain shared memory link instead of running its own detector.</li>
 	</ul>
 	<li><b>SC Preamp</b> - applies additional gain to the sidechain band.</li>
 	<li><b>Makeup</b> - applies additional gain to the output of the corresponding compressor.</li>
@@ -218,10 +249,12 @@
 	<?php if ($sc) { ?>
 	<li><b>In -> SC</b> - the amount of signal from input channel added to the Sidechain.</li>
 	<?php } ?>
-	<li><b>In -> Link</b> - the amount of signal from input channel added to the shared memory link.</li>
+	<li><b>In -> Link</b> - the amount of signal from input channel added to the shared memory link, not applied while
+	the <b>Processed Link</b> signal is received.</li>
 	<?php if ($sc) { ?>
 	<li><b>SC -> In</b> - the amount of signal from sidechain input channel added to the input channel.</li>
-	<li><b>SC -> Link</b> - the amount of signal from sidechain input channel added to the shared memory link.</li>
+	<li><b>SC -> Link</b> - the amount of signal from sidechain input channel added to the shared memory link, not applied while
+	the <b>Processed Link</b> signal is received.</li>
 	<?php } ?>
 	<li><b>Link -> In</b> - the amount of signal from shared memory link added to the input channel.</li>
 	<li><b>Link -> SC</b> - the amount of signal from shared memory link added to the sidechain channel.</li>
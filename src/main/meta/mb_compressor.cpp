@@ -27,7 +27,7 @@
 
 #define LSP_PLUGINS_MB_COMPRESSOR_VERSION_MAJOR       1
 #define LSP_PLUGINS_MB_COMPRESSOR_VERSION_MINOR       0
-#define LSP_PLUGINS_MB_COMPRESSOR_VERSION_MICRO       32
+#define LSP_PLUGINS_MB_COMPRESSOR_VERSION_MICRO       33
 
 #define LSP_PLUGINS_MB_COMPRESSOR_VERSION  \
     LSP_MODULE_VERSION( \
@@ -50,6 +50,7 @@ namespace lsp
         {
             { "Internal",       "sidechain.internal"        },
             { "Link",           "sidechain.link"            },
+            { "Link Gain",      "mb_comp.link_gain"         },
             { NULL, NULL }
         };
 
@@ -58,6 +59,7 @@ namespace lsp
             { "Internal",       "sidechain.internal"        },
             { "External",       "sidechain.external"        },
             { "Link",           "sidechain.link"            },
+            { "Link Gain",      "mb_comp.link_gain"         },
             { NULL, NULL }
         };
 
@@ -102,6 +104,25 @@ namespace lsp
             { NULL, NULL }
         };
 
+        static const port_item_t mb_comp_det_oversampling[] =
+        {
+            { "None",           "mb_comp.oversampling.none" },
+            { "2x",             "mb_comp.oversampling.x2" },
+            { "4x",             "mb_comp.oversampling.x4" },
+            { NULL, NULL }
+        };
+
+        static const port_item_t mb_comp_xover_latency[] =
+        {
+            { "Fixed",          "mb_comp.latency.fixed" },
+            { "Adaptive",       "mb_comp.latency.adaptive" },
+            { "Max 4096",       "mb_comp.latency.max_4096" },
+            { "Max 2048",       "mb_comp.latency.max_2048" },
+            { "Max 1024",       "mb_comp.latency.max_1024" },
+            { "Max 512",        "mb_comp.latency.max_512" },
+            { NULL, NULL }
+        };
+
         static const port_item_t mb_comp_modes[] =
         {
             { "Down",           "mb_comp.down_ward" },
@@ -162,11 +183,34 @@ namespace lsp
             { NULL, NULL }
         };
 
+        static const port_item_t mb_comp_gain_link_bands[] =
+        {
+            { "Band 0",         "mb_comp.band0" },
+            { "Band 1",         "mb_comp.band1" },
+            { "Band 2",         "mb_comp.band2" },
+            { "Band 3",         "mb_comp.band3" },
+            { "Band 4",         "mb_comp.band4" },
+            { "Band 5",         "mb_comp.band5" },
+            { "Band 6",         "mb_comp.band6" },
+            { "Band 7",         "mb_comp.band7" },
+            { NULL, NULL }
+        };
+
         #define MB_COMP_SHM_LINK_MONO \
-                OPT_RETURN_MONO("link", "shml", "Side-chain shared memory link")
+                OPT_RETURN_MONO("link", "shml", "Side-chain shared memory link"), \
+                OPT_SEND_MONO("plink", "shmp", "Processed side-chain shared memory link"), \
+                OPT_RETURN_MONO("plinkr", "shmpr", "Processed side-chain shared memory link return"), \
+                OPT_SEND_MONO("glink", "shmg", "Gain shared memory link"), \
+                OPT_RETURN_MONO("glinkr", "shmgr", "Gain shared memory link return"), \
+                COMBO("glb", "Gain link band", "Gain link band", 0, mb_comp_gain_link_bands)
 
         #define MB_COMP_SHM_LINK_STEREO \
-                OPT_RETURN_STEREO("link", "shml_", "Side-chain shared memory link")
+                OPT_RETURN_STEREO("link", "shml_", "Side-chain shared memory link"), \
+                OPT_SEND_STEREO("plink", "shmp_", "Processed side-chain shared memory link"), \
+                OPT_RETURN_STEREO("plinkr", "shmpr_", "Processed side-chain shared memory link return"), \
+                OPT_SEND_STEREO("glink", "shmg_", "Gain shared memory link"), \
+                OPT_RETURN_STEREO("glinkr", "shmgr_", "Gain shared memory link return"), \
+                COMBO("glb", "Gain link band", "Gain link band", 0, mb_comp_gain_link_bands)
 
         #define MB_COMP_PREMIX \
                 SWITCH("showpmx", "Show pre-mix overlay", "Show premix bar", 0.0f), \
@@ -192,6 +236,9 @@ namespace lsp
                 AMP_GAIN("shift", "Shift gain", "Shift", 1.0f, 100.0f), \
                 LOG_CONTROL("zoom", "Graph zoom", "Zoom", U_GAIN_AMP, mb_compressor_metadata::ZOOM), \
                 COMBO("envb", "Envelope boost", "Env boost", mb_compressor_metadata::FB_DEFAULT, mb_comp_sc_boost), \
+                COMBO("dovs", "Detector oversampling", "Det oversampling", mb_compressor_metadata::OVS_DEFAULT, mb_comp_det_oversampling), \
+                SWITCH("acr", "Adaptive control rate", "Adaptive rate", 0.0f), \
+                COMBO("axl", "Crossover latency", "XOver latency", mb_compressor_metadata::XLAT_DEFAULT, mb_comp_xover_latency), \
                 COMBO("bsel", "Band selection", "Band selector", mb_compressor_metadata::SC_BAND_DFL, bands)
 
         #define MB_SPLIT(id, label, alias, enable, freq) \
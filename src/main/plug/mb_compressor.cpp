@@ -29,9 +29,36 @@
 #include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
 #include <lsp-plug.in/shared/debug.h>
 #include <lsp-plug.in/shared/id_colors.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#ifdef MB_COMPRESSOR_PROFILING
+    #if defined(ARCH_X86)
+        #include <x86intrin.h>
+    #else
+        #include <time.h>
+    #endif /* ARCH_X86 */
+#endif /* MB_COMPRESSOR_PROFILING */
 
 #define MBC_BUFFER_SIZE         0x200U
 
+// Per-stage profiling of the hot path, enabled by defining MB_COMPRESSOR_PROFILING at configuration
+// time: 'CXXFLAGS=-DMB_COMPRESSOR_PROFILING make config'. Stage times are reported by dump() in CPU cycles on x86 and in
+// nanoseconds on other architectures, the unit is dumped along with the values.
+#ifdef MB_COMPRESSOR_PROFILING
+    #define MBC_PROFILE_START(var)          const uint64_t var = profile_clock()
+    #define MBC_PROFILE_COMMIT(t, var)      commit_stage_time(t, var)
+
+    #if defined(ARCH_X86)
+        #define MBC_PROFILE_UNIT                "cycles"
+    #else
+        #define MBC_PROFILE_UNIT                "ns"
+    #endif /* ARCH_X86 */
+#else
+    #define MBC_PROFILE_START(var)
+    #define MBC_PROFILE_COMMIT(t, var)
+#endif /* MB_COMPRESSOR_PROFILING */
+
 namespace lsp
 {
     namespace plugins
@@ -89,12 +116,20 @@ namespace lsp
             plug::Module(metadata)
         {
             nMode           = mode;
+            nChannels       = (mode == MBCM_MONO) ? 1 : 2;
             bSidechain      = sc;
             bEnvUpdate      = true;
-            bUseShmLink     = false;
+            nScSources      = 0;
+            bLinkActive     = false;
+            nGainLinkBand   = 0;
             enXOver         = XOVER_MODERN;
+            pApplyVCA       = &mb_compressor::apply_vca_modern;
             bStereoSplit    = false;
+            bSingleBand     = false;
+            bAdaptiveRate   = false;
+            nXOverLatency   = meta::mb_compressor_metadata::XLAT_DEFAULT;
             nEnvBoost       = meta::mb_compressor_metadata::FB_DEFAULT;
+            nOversampling   = 1;
             vChannels       = NULL;
             fInGain         = GAIN_AMP_0_DB;
             fDryGain        = GAIN_AMP_M_INF_DB;
@@ -108,6 +143,10 @@ namespace lsp
             vCurve          = NULL;
             vIndexes        = NULL;
             pIDisplay       = NULL;
+            vIDisplayIdx    = NULL;
+            nIDisplayWidth  = 0;
+            bIDisplayUpdate = true;
+            bIDisplayBypass = false;
             vSc[0]          = NULL;
             vSc[1]          = NULL;
             vAnalyze[0]     = NULL;
@@ -116,6 +155,15 @@ namespace lsp
             vAnalyze[3]     = NULL;
             vBuffer         = NULL;
             vEnv            = NULL;
+            vZero           = NULL;
+            vOvsSc[0]       = NULL;
+            vOvsSc[1]       = NULL;
+            vOvsEnv         = NULL;
+
+        #ifdef MB_COMPRESSOR_PROFILING
+            for (size_t i=0; i<PS_TOTAL; ++i)
+                reset_stage_time(&vStageTime[i]);
+        #endif /* MB_COMPRESSOR_PROFILING */
 
             sPremix.fInToSc     = GAIN_AMP_M_INF_DB;
             sPremix.fInToLink   = GAIN_AMP_M_INF_DB;
@@ -131,8 +179,6 @@ namespace lsp
                 sPremix.vSc[i]      = NULL;
                 sPremix.vLink[i]    = NULL;
                 sPremix.vTmpIn[i]   = NULL;
-                sPremix.vTmpSc[i]   = NULL;
-                sPremix.vTmpLink[i] = NULL;
             }
 
             sPremix.pInToSc     = NULL;
@@ -142,6 +188,7 @@ namespace lsp
             sPremix.pScToIn     = NULL;
             sPremix.pScToLink   = NULL;
 
+            pGainLinkBand   = NULL;
             pBypass         = NULL;
             pMode           = NULL;
             pInGain         = NULL;
@@ -153,6 +200,9 @@ namespace lsp
             pShiftGain      = NULL;
             pZoom           = NULL;
             pEnvBoost       = NULL;
+            pOversampling   = NULL;
+            pAdaptiveRate   = NULL;
+            pXOverLatency   = NULL;
             pStereoSplit    = NULL;
         }
 
@@ -180,6 +230,17 @@ namespace lsp
             return dspu::CM_DOWNWARD;
         }
 
+        dspu::over_mode_t mb_compressor::decode_oversampling(int mode)
+        {
+            switch (mode)
+            {
+                case meta::mb_compressor_metadata::OVS_2X:      return dspu::OM_LANCZOS_2X3;
+                case meta::mb_compressor_metadata::OVS_4X:      return dspu::OM_LANCZOS_4X3;
+                default: break;
+            }
+            return dspu::OM_NONE;
+        }
+
         dspu::sidechain_source_t mb_compressor::decode_sidechain_source(int source, bool split, size_t channel)
         {
             if (!split)
@@ -234,13 +295,10 @@ namespace lsp
 
         void mb_compressor::do_destroy()
         {
-            // Determine number of channels
-            size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
-
             // Destroy channels
             if (vChannels != NULL)
             {
-                for (size_t i=0; i<channels; ++i)
+                for (size_t i=0; i<nChannels; ++i)
                 {
                     channel_t *c    = &vChannels[i];
 
@@ -263,6 +321,8 @@ namespace lsp
                         b->sEQ[1].destroy();
                         b->sSC.destroy();
                         b->sScDelay.destroy();
+                        b->sOver[0].destroy();
+                        b->sOver[1].destroy();
 
                         b->sPassFilter.destroy();
                         b->sRejFilter.destroy();
@@ -286,6 +346,11 @@ namespace lsp
                 pIDisplay->destroy();
                 pIDisplay   = NULL;
             }
+            if (vIDisplayIdx != NULL)
+            {
+                free(vIDisplayIdx);
+                vIDisplayIdx    = NULL;
+            }
 
             // Destroy analyzer
             sAnalyzer.destroy();
@@ -296,11 +361,8 @@ namespace lsp
             // Initialize plugin
             plug::Module::init(wrapper, ports);
 
-            // Determine number of channels
-            size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
-
             // Allocate channels
-            vChannels       = new channel_t[channels];
+            vChannels       = new channel_t[nChannels];
             if (vChannels == NULL)
                 return;
 
@@ -322,13 +384,16 @@ namespace lsp
                     meta::mb_compressor_metadata::FFT_MESH_POINTS * sizeof(uint32_t) + // vIndexes array
                     MBC_BUFFER_SIZE * sizeof(float) + // Global vBuffer for band signal processing
                     MBC_BUFFER_SIZE * sizeof(float) + // Global vEnv for band signal processing
+                    MBC_BUFFER_SIZE * sizeof(float) + // Global vZero for missing data
+                    MBC_BUFFER_SIZE * meta::mb_compressor_metadata::OVERSAMPLING_MAX * sizeof(float) + // vOvsEnv
                     // Channel buffers
                     (
-                        MBC_BUFFER_SIZE * sizeof(float) * 3 + // Premix
+                        MBC_BUFFER_SIZE * sizeof(float) + // Premix
                         MBC_BUFFER_SIZE * sizeof(float) + // Global vSc[] for each channel
+                        MBC_BUFFER_SIZE * meta::mb_compressor_metadata::OVERSAMPLING_MAX * sizeof(float) + // Global vOvsSc[] for each channel
                         2 * filter_mesh_size + // vTr of each channel
                         filter_mesh_size + // vTrMem of each channel
-                        MBC_BUFFER_SIZE * sizeof(float) + // vInAnalyze for each channel
+                        MBC_BUFFER_SIZE * sizeof(float) + // vAnBuffer for each channel
                         MBC_BUFFER_SIZE * sizeof(float) + // vInBuffer for each channel
                         MBC_BUFFER_SIZE * sizeof(float) + // vBuffer for each channel
                         ((bSidechain) ? MBC_BUFFER_SIZE * sizeof(float) : 0) + // vScBuffer for each channel
@@ -341,7 +406,7 @@ namespace lsp
                             meta::mb_compressor_metadata::FFT_MESH_POINTS * 2 * sizeof(float) + // vSc transfer function for each band
                             meta::mb_compressor_metadata::FFT_MESH_POINTS * 2 * sizeof(float) // vTr transfer function for each band
                         ) * meta::mb_compressor_metadata::BANDS_MAX
-                    ) * channels;
+                    ) * nChannels;
 
             uint8_t *ptr    = alloc_aligned<uint8_t>(pData, to_alloc);
             if (ptr == NULL)
@@ -356,25 +421,28 @@ namespace lsp
             vCurve          = advance_ptr_bytes<float>(ptr, meta::mb_compressor_metadata::CURVE_MESH_SIZE * sizeof(float));
             vIndexes        = advance_ptr_bytes<uint32_t>(ptr, meta::mb_compressor_metadata::FFT_MESH_POINTS * sizeof(uint32_t));
             vSc[0]          = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
-            vSc[1]          = (channels > 1) ? advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float)) : NULL;
+            vSc[1]          = (nChannels > 1) ? advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float)) : NULL;
             vBuffer         = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
             vEnv            = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
+            vZero           = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
+            dsp::fill_zero(vZero, MBC_BUFFER_SIZE);
+            vOvsSc[0]       = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * meta::mb_compressor_metadata::OVERSAMPLING_MAX * sizeof(float));
+            vOvsSc[1]       = (nChannels > 1) ? advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * meta::mb_compressor_metadata::OVERSAMPLING_MAX * sizeof(float)) : NULL;
+            vOvsEnv         = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * meta::mb_compressor_metadata::OVERSAMPLING_MAX * sizeof(float));
 
             // Initialize pre-mix
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 sPremix.vTmpIn[i]       = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
-                sPremix.vTmpLink[i]     = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
-                sPremix.vTmpSc[i]       = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
             }
 
             // Initialize filters according to number of bands
-            if (sFilters.init(meta::mb_compressor_metadata::BANDS_MAX * channels) != STATUS_OK)
+            if (sFilters.init(meta::mb_compressor_metadata::BANDS_MAX * nChannels) != STATUS_OK)
                 return;
             size_t filter_cid = 0;
 
             // Initialize channels
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
 
@@ -399,17 +467,26 @@ namespace lsp
                 c->sDryEq.set_mode(dspu::EQM_IIR);
 
                 c->nPlanSize    = 0;
+                c->nXOverRank   = 0;
                 c->vIn          = NULL;
+                c->vInData      = NULL;
                 c->vOut         = NULL;
                 c->vScIn        = NULL;
                 c->vShmIn       = NULL;
+                c->vShmGainOut  = NULL;
+                c->vShmGainIn   = NULL;
+                c->vShmProcIn   = NULL;
+                c->vShmProcOut  = NULL;
 
-                c->vInAnalyze   = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
+                c->vInAnalyze   = NULL;
+                c->vAnBuffer    = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
                 c->vInBuffer    = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
+                c->vInDelayed   = NULL;
                 c->vBuffer      = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
                 c->vScBuffer    = (bSidechain) ? advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float)) : NULL;
                 c->vExtScBuffer = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
                 c->vShmBuffer   = advance_ptr_bytes<float>(ptr, MBC_BUFFER_SIZE * sizeof(float));
+                c->vShmLink     = NULL;
                 c->vTr          = advance_ptr_bytes<float>(ptr, 2 * filter_mesh_size);
                 c->vTrMem       = advance_ptr_bytes<float>(ptr, filter_mesh_size);
 
@@ -420,11 +497,17 @@ namespace lsp
 
                 c->bInFft       = false;
                 c->bOutFft      = false;
+                c->bXOver       = false;
+                c->nSync        = S_AMP_CURVE;
 
                 c->pIn          = NULL;
                 c->pOut         = NULL;
                 c->pScIn        = NULL;
                 c->pShmIn       = NULL;
+                c->pShmGainOut  = NULL;
+                c->pShmGainIn   = NULL;
+                c->pShmProcOut  = NULL;
+                c->pShmProcIn   = NULL;
                 c->pFftIn       = NULL;
                 c->pFftInSw     = NULL;
                 c->pFftOut      = NULL;
@@ -439,7 +522,7 @@ namespace lsp
                 {
                     comp_band_t *b  = &c->vBands[j];
 
-                    if (!b->sSC.init(channels, meta::mb_compressor_metadata::REACTIVITY_MAX))
+                    if (!b->sSC.init(nChannels, meta::mb_compressor_metadata::REACTIVITY_MAX))
                         return;
                     if (!b->sPassFilter.init(NULL))
                         return;
@@ -447,11 +530,17 @@ namespace lsp
                         return;
                     if (!b->sAllFilter.init(NULL))
                         return;
+                    for (size_t k=0; k<nChannels; ++k)
+                    {
+                        if (!b->sOver[k].init())
+                            return;
+                        b->sOver[k].set_filtering(false);
+                    }
 
                     // Initialize sidechain equalizers
                     b->sEQ[0].init(2, 6);
                     b->sEQ[0].set_mode(dspu::EQM_IIR);
-                    if (channels > 1)
+                    if (nChannels > 1)
                     {
                         b->sEQ[1].init(2, 6);
                         b->sEQ[1].set_mode(dspu::EQM_IIR);
@@ -471,6 +560,19 @@ namespace lsp
                     b->fFreqLCF     = 0.0f;
                     b->fMakeup      = GAIN_AMP_0_DB;
                     b->fGainLevel   = GAIN_AMP_0_DB;
+                    b->fEnvLevel    = 0.0f;
+                    b->fCurveLevel  = 0.0f;
+                    b->fReduction   = GAIN_AMP_0_DB;
+                    b->fCtlPeak     = 0.0f;
+                    b->fCtlFrom     = GAIN_AMP_0_DB;
+                    b->fCtlTo       = GAIN_AMP_0_DB;
+                    b->nLookahead   = 0;
+                    b->nCtlPeriod   = 1;
+                    b->nCtlPhase    = 0;
+                #ifdef MB_COMPRESSOR_PROFILING
+                    reset_stage_time(&b->sScTime);
+                    reset_stage_time(&b->sCompTime);
+                #endif /* MB_COMPRESSOR_PROFILING */
                     b->bEnabled     = j < meta::mb_compressor_metadata::BANDS_DFL;
                     b->bCustHCF     = false;
                     b->bCustLCF     = false;
@@ -479,6 +581,7 @@ namespace lsp
                     b->nScType      = SCT_INTERNAL;
                     b->nSync        = S_ALL;
                     b->nFilterID    = filter_cid++;
+                    b->pDetector    = b;
 
                     b->pScType      = NULL;
                     b->pScSource    = NULL;
@@ -534,27 +637,40 @@ namespace lsp
 
             // Input ports
             lsp_trace("Binding input ports");
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
                 BIND_PORT(vChannels[i].pIn);
 
             // Input ports
             lsp_trace("Binding output ports");
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
                 BIND_PORT(vChannels[i].pOut);
 
             // Input ports
             if (bSidechain)
             {
                 lsp_trace("Binding sidechain ports");
-                for (size_t i=0; i<channels; ++i)
+                for (size_t i=0; i<nChannels; ++i)
                     BIND_PORT(vChannels[i].pScIn);
             }
 
             // Shared memory link
             lsp_trace("Binding shared memory link");
             SKIP_PORT("Shared memory link name");
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
                 BIND_PORT(vChannels[i].pShmIn);
+            SKIP_PORT("Processed shared memory link name");
+            for (size_t i=0; i<nChannels; ++i)
+                BIND_PORT(vChannels[i].pShmProcOut);
+            SKIP_PORT("Processed shared memory link return name");
+            for (size_t i=0; i<nChannels; ++i)
+                BIND_PORT(vChannels[i].pShmProcIn);
+            SKIP_PORT("Gain shared memory link name");
+            for (size_t i=0; i<nChannels; ++i)
+                BIND_PORT(vChannels[i].pShmGainOut);
+            SKIP_PORT("Gain shared memory link return name");
+            for (size_t i=0; i<nChannels; ++i)
+                BIND_PORT(vChannels[i].pShmGainIn);
+            BIND_PORT(pGainLinkBand);
 
             // Pre-mixing ports
             lsp_trace("Binding pre-mix ports");
@@ -582,12 +698,15 @@ namespace lsp
             BIND_PORT(pShiftGain);
             BIND_PORT(pZoom);
             BIND_PORT(pEnvBoost);
+            BIND_PORT(pOversampling);
+            BIND_PORT(pAdaptiveRate);
+            BIND_PORT(pXOverLatency);
             SKIP_PORT("Band selector"); // Skip band selector
             if ((nMode == MBCM_LR) || (nMode == MBCM_MS))
                 SKIP_PORT("Separate channels link");
 
             lsp_trace("Binding channel ports");
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
 
@@ -600,7 +719,7 @@ namespace lsp
                 BIND_PORT(pStereoSplit);
 
             lsp_trace("Binding meters");
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
 
@@ -614,7 +733,7 @@ namespace lsp
 
             // Split frequencies
             lsp_trace("Binding split frequencies");
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX-1; ++j)
                 {
@@ -636,7 +755,7 @@ namespace lsp
 
             // Compressor bands
             lsp_trace("Binding compressor bands");
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
                 {
@@ -722,7 +841,7 @@ namespace lsp
 
             // Compressor band meters
             lsp_trace("Binding compressor band meters");
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
                 {
@@ -749,6 +868,7 @@ namespace lsp
                     case 0: return SCT_INTERNAL;
                     case 1: return SCT_EXTERNAL;
                     case 2: return SCT_LINK;
+                    case 3: return SCT_LINK_GAIN;
                     default: break;
                 }
             }
@@ -758,6 +878,7 @@ namespace lsp
                 {
                     case 0: return SCT_INTERNAL;
                     case 1: return SCT_LINK;
+                    case 2: return SCT_LINK_GAIN;
                     default: break;
                 }
             }
@@ -780,9 +901,8 @@ namespace lsp
             dspu::filter_params_t fp;
 
             update_premix();
+            nGainLinkBand       = lsp_min(size_t(pGainLinkBand->value()), meta::mb_compressor_metadata::BANDS_MAX - 1);
 
-            // Determine number of channels
-            size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
             int active_channels = 0;
             size_t env_boost    = pEnvBoost->value();
 
@@ -791,13 +911,57 @@ namespace lsp
             if (xover != enXOver)
             {
                 enXOver             = xover;
-                for (size_t i=0; i<channels; ++i)
+                switch (enXOver)
+                {
+                    case XOVER_CLASSIC:
+                        pApplyVCA           = &mb_compressor::apply_vca_classic;
+                        break;
+                    case XOVER_LINEAR_PHASE:
+                        pApplyVCA           = &mb_compressor::apply_vca_linear_phase;
+                        break;
+                    case XOVER_MODERN:
+                    default:
+                        pApplyVCA           = &mb_compressor::apply_vca_modern;
+                        break;
+                }
+                for (size_t i=0; i<nChannels; ++i)
                 {
                     vChannels[i].nPlanSize      = 0;
+                    vChannels[i].bXOver         = false;
                     vChannels[i].sXOverDelay.clear();
                 }
+                resize_sc_delays();
             }
             bStereoSplit        = (pStereoSplit != NULL) ? pStereoSplit->value() >= 0.5f : false;
+            bAdaptiveRate       = pAdaptiveRate->value() >= 0.5f;
+            nXOverLatency       = pXOverLatency->value();
+
+            // Update detector oversampling
+            const dspu::over_mode_t ovs_mode    = decode_oversampling(pOversampling->value());
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
+                {
+                    comp_band_t *b      = &c->vBands[j];
+                    for (size_t k=0; k<nChannels; ++k)
+                    {
+                        b->sOver[k].set_mode(ovs_mode);
+                        if (b->sOver[k].modified())
+                            b->sOver[k].update_settings();
+                    }
+                }
+            }
+            const size_t oversampling   = vChannels[0].vBands[0].sOver[0].get_oversampling();
+            if (oversampling != nOversampling)
+            {
+                // The sidechain runs at the oversampled rate. Re-rating it reallocates the history
+                // buffer, so it is done only when the oversampling factor changes
+                nOversampling       = oversampling;
+                for (size_t i=0; i<nChannels; ++i)
+                    for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
+                        vChannels[i].vBands[j].sSC.set_sample_rate(fSampleRate * nOversampling);
+            }
 
             // Store gain
             const float out_gain= pOutGain->value();
@@ -805,14 +969,24 @@ namespace lsp
             const float dry_gain= pDryGain->value();
             const float wet_gain= pWetGain->value();
 
+            const float old_dry = fDryGain;
             fInGain             = pInGain->value();
             fDryGain            = (dry_gain * drywet + 1.0f - drywet) * out_gain;
             fWetGain            = wet_gain * drywet * out_gain;
             fZoom               = pZoom->value();
-            bUseShmLink         = false;
+            nScSources          = 0;
+
+            // The dry equalizer is not processed while the dry gain is zero, drop its stale state
+            if ((old_dry == 0.0f) && (fDryGain != 0.0f))
+            {
+                for (size_t i=0; i<nChannels; ++i)
+                    vChannels[i].sDryEq.reset();
+            }
+
+            bSingleBand         = true;
 
             // Configure channels
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
 
@@ -897,13 +1071,16 @@ namespace lsp
             {
                 sAnalyzer.reconfigure();
                 sAnalyzer.get_frequencies(vFreqs, vIndexes, SPEC_FREQ_MIN, SPEC_FREQ_MAX, meta::mb_compressor_metadata::MESH_POINTS);
+                nIDisplayWidth      = 0; // Frequency axis of the inline display needs to be recomputed
+                for (size_t i=0; i<nChannels; ++i)
+                    vChannels[i].nSync     |= S_AMP_CURVE;
             }
 
             size_t latency = 0;
             bool solo_on = false;
 
             // Configure channels
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
 
@@ -930,8 +1107,6 @@ namespace lsp
                     b->pRelLevelOut->set_value(release);
 
                     b->nScType      = decode_sidechain_type(b->pScType->value());
-                    if (b->nScType == SCT_LINK)
-                        bUseShmLink     = true;
 
                     b->sSC.set_mode(b->pScMode->value());
                     b->sSC.set_reactivity(b->pScReact->value());
@@ -952,6 +1127,17 @@ namespace lsp
                     b->sComp.set_knee(b->pKnee->value());
                     b->sComp.set_boost_threshold((mode != dspu::CM_BOOSTING) ? b->pBThresh->value() : b->pBoost->value());
 
+                    // Select the control period of the gain computer
+                    size_t period   = (bAdaptiveRate) ? select_control_period(fSampleRate, b->pAttTime->value(), b->pRelTime->value()) : 1;
+                    if (period != b->nCtlPeriod)
+                    {
+                        b->nCtlPeriod   = period;
+                        b->nCtlPhase    = 0;
+                        b->fCtlPeak     = 0.0f;
+                        b->fCtlFrom     = b->fCtlTo;
+                        b->sComp.set_sample_rate(fSampleRate / period);
+                    }
+
                     if (b->sComp.modified())
                     {
                         b->sComp.update_settings();
@@ -1018,7 +1204,18 @@ namespace lsp
                 }
             }
 
-            for (size_t i=0; i<channels; ++i)
+            // Bands of linked stereo channels receive exactly the same sidechain signal and settings,
+            // so the detector is evaluated only once by the band of the left channel
+            const bool link_channels = (nMode == MBCM_STEREO) && (!bStereoSplit);
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c    = &vChannels[i];
+                channel_t *lead = (link_channels) ? &vChannels[0] : c;
+                for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
+                    c->vBands[j].pDetector  = &lead->vBands[j];
+            }
+
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
 
@@ -1080,7 +1277,7 @@ namespace lsp
                         lsp_trace("plan[%d] start=%f, end=%f", int(j), b->fFreqStart, b->fFreqEnd);
 
                         // Configure equalizer for the sidechain
-                        for (size_t k=0; k<channels; ++k)
+                        for (size_t k=0; k<nChannels; ++k)
                         {
                             // Configure lo-pass filter
                             fp.nType        = ((j != (c->nPlanSize-1)) || (b->bCustHCF)) ? dspu::FLT_BT_LRX_LOPASS : dspu::FLT_NONE;
@@ -1213,19 +1410,49 @@ namespace lsp
                     c->sDryEq.set_params(j, &fp);
                 }
 
-                // Calculate latency
+                // Calculate latency and sidechain sources required by active detectors,
+                // bands with received gain do not use the sidechain signal at all
+                if (c->nPlanSize > 1)
+                    bSingleBand         = false;
                 for (size_t j=0; j<c->nPlanSize; ++j)
                 {
                     comp_band_t *b  = c->vPlan[j];
                     latency         = lsp_max(latency, b->nLookahead);
+                    if ((b->bEnabled) && (b->pDetector == b) && (b->nScType != SCT_LINK_GAIN))
+                        nScSources     |= 1 << b->nScType;
+                }
+            }
+
+            // Select the FFT rank of the crossover by the lowest split frequency of all channels
+            float split_min     = fSampleRate >> 1;
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                const channel_t *c  = &vChannels[i];
+                if (c->nPlanSize > 1)
+                    split_min           = lsp_min(split_min, c->vPlan[1]->fFreqStart);
+            }
+            const size_t xover_rank = select_xover_rank(fSampleRate, split_min, nXOverLatency);
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                if (c->sFFTXOver.rank() != xover_rank)
+                {
+                    lsp_trace("xover rank[%d] = %d", int(i), int(xover_rank));
+                    c->sFFTXOver.set_rank(xover_rank);
+
+                    // Band curves depend on the FFT resolution
+                    for (size_t j=0; j<c->nPlanSize; ++j)
+                        c->vPlan[j]->nSync     |= S_BAND_CURVE;
                 }
             }
 
-            // Update latency
-            size_t xover_latency = (enXOver == XOVER_LINEAR_PHASE) ? vChannels[0].sFFTXOver.latency() : 0;
+            // Update latency, single band does not need the crossover
+            size_t xover_latency = ((enXOver == XOVER_LINEAR_PHASE) && (!bSingleBand)) ? vChannels[0].sFFTXOver.latency() : 0;
+            size_t det_latency  = vChannels[0].vBands[0].sOver[0].latency();
+            latency            += det_latency;
 
             set_latency(latency + xover_latency);
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
 
@@ -1233,13 +1460,13 @@ namespace lsp
                 for (size_t j=0; j<c->nPlanSize; ++j)
                 {
                     comp_band_t *b  = c->vPlan[j];
-                    b->sScDelay.set_delay(latency + xover_latency - b->nLookahead);
+                    update_delay(&b->sScDelay, latency + xover_latency - b->nLookahead - det_latency);
                     lsp_trace("scdelay[%d][%d] = %d", int(i), int(j), int(b->sScDelay.get_delay()));
                 }
-                c->sDelay.set_delay(latency);
-                c->sDryDelay.set_delay(latency + xover_latency);
+                update_delay(&c->sDelay, latency);
+                update_delay(&c->sDryDelay, latency + xover_latency);
                 sAnalyzer.set_channel_delay(c->nAnInChannel, xover_latency);
-                c->sXOverDelay.set_delay(xover_latency);
+                update_delay(&c->sXOverDelay, xover_latency);
 
                 lsp_trace("sdelay[%d] = %d", int(i), int(c->sDelay.get_delay()));
                 lsp_trace("drydelay[%d] = %d", int(i), int(c->sDryDelay.get_delay()));
@@ -1249,7 +1476,7 @@ namespace lsp
 
             // Debug:
     #ifdef LSP_TRACE
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
 
@@ -1273,6 +1500,7 @@ namespace lsp
 
             nEnvBoost       = env_boost;
             bEnvUpdate      = false;
+            bIDisplayUpdate = true;
         }
 
         size_t mb_compressor::select_fft_rank(size_t sample_rate)
@@ -1282,17 +1510,49 @@ namespace lsp
             return meta::mb_compressor_metadata::FFT_XOVER_RANK_MIN + n;
         }
 
+        size_t mb_compressor::select_xover_rank(size_t sample_rate, float split, size_t mode)
+        {
+            const size_t rank   = select_fft_rank(sample_rate);
+            if (mode == meta::mb_compressor_metadata::XLAT_FIXED)
+                return rank;
+
+            // Each octave of the lowest split frequency above the reference one allows to halve the FFT size
+            size_t res          = rank;
+            if (split > meta::mb_compressor_metadata::FFT_XOVER_SPLIT_REF)
+            {
+                const size_t shift  = log2f(split / meta::mb_compressor_metadata::FFT_XOVER_SPLIT_REF);
+                res                 = (rank > meta::mb_compressor_metadata::FFT_XOVER_RANK_LOW + shift) ?
+                    rank - shift : lsp_min(rank, meta::mb_compressor_metadata::FFT_XOVER_RANK_LOW);
+            }
+
+            // Apply the user cap of the FFT size, the lowest cap matches the lowest rank
+            if (mode > meta::mb_compressor_metadata::XLAT_ADAPTIVE)
+            {
+                const size_t cap    = meta::mb_compressor_metadata::FFT_XOVER_RANK_LOW +
+                                      meta::mb_compressor_metadata::XLAT_512 - lsp_min(mode, size_t(meta::mb_compressor_metadata::XLAT_512));
+                res                 = lsp_min(res, cap);
+            }
+
+            return res;
+        }
+
         void mb_compressor::update_sample_rate(long sr)
         {
-            // Determine number of channels
-            size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
             size_t fft_rank     = select_fft_rank(sr);
             size_t bins         = 1 << fft_rank;
-            size_t max_delay    = bins + dspu::millis_to_samples(sr, meta::mb_compressor_metadata::LOOKAHEAD_MAX);
+
+            // Size each delay line by the maximum delay it can take in its role:
+            //   - lookahead compensation never includes the crossover latency;
+            //   - crossover compensation never includes the lookahead;
+            //   - dry signal delay may include both;
+            //   - sidechain delays are sized by resize_sc_delays() for the current crossover mode.
+            size_t max_lookahead= dspu::millis_to_samples(sr, meta::mb_compressor_metadata::LOOKAHEAD_MAX) +
+                                  meta::mb_compressor_metadata::OVERSAMPLING_LATENCY;
+            size_t max_delay    = bins + max_lookahead;
 
             // Update analyzer's sample rate
             sAnalyzer.init(
-                2*channels,
+                2*nChannels,
                 meta::mb_compressor_metadata::FFT_RANK,
                 MAX_SAMPLE_RATE,
                 meta::mb_compressor_metadata::REFRESH_RATE,
@@ -1309,23 +1569,26 @@ namespace lsp
             bEnvUpdate          = true;
 
             // Update channels
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c = &vChannels[i];
                 c->sBypass.init(sr);
-                c->sDelay.init(max_delay);
+                c->sDelay.init(max_lookahead);
                 c->sDryDelay.init(max_delay);
-                c->sXOverDelay.init(max_delay);
+                c->sXOverDelay.init(bins);
                 c->sDryEq.set_sample_rate(sr);
 
-                // Need to re-initialize FFT crossover?
-                if (fft_rank != c->sFFTXOver.rank())
+                // Need to re-initialize FFT crossover? The working rank may be lower than the allocated one
+                if (fft_rank != c->nXOverRank)
                 {
                     c->sFFTXOver.init(fft_rank, meta::mb_compressor_metadata::BANDS_MAX);
+                    c->nXOverRank       = fft_rank;
                     for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
                         c->sFFTXOver.set_handler(j, process_band, this, c);
                     c->sFFTXOver.set_rank(fft_rank);
-                    c->sFFTXOver.set_phase(float(i) / float(channels));
+                    c->sFFTXOver.set_phase(float(i) / float(nChannels));
+                    for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
+                        c->vBands[j].nSync     |= S_BAND_CURVE;
                 }
                 c->sFFTXOver.set_sample_rate(sr);
 
@@ -1334,30 +1597,47 @@ namespace lsp
                 {
                     comp_band_t *b  = &c->vBands[j];
 
-                    b->sSC.set_sample_rate(sr);
-                    b->sComp.set_sample_rate(sr);
-                    b->sScDelay.init(max_delay);
+                    b->sSC.set_sample_rate(sr * nOversampling);
+                    for (size_t k=0; k<nChannels; ++k)
+                    {
+                        b->sOver[k].set_sample_rate(sr);
+                        if (b->sOver[k].modified())
+                            b->sOver[k].update_settings();
+                    }
+                    b->sComp.set_sample_rate(sr / b->nCtlPeriod);
 
                     b->sPassFilter.set_sample_rate(sr);
                     b->sRejFilter.set_sample_rate(sr);
                     b->sAllFilter.set_sample_rate(sr);
 
                     b->sEQ[0].set_sample_rate(sr);
-                    if (channels > 1)
+                    if (nChannels > 1)
                         b->sEQ[1].set_sample_rate(sr);
                 }
 
                 c->nPlanSize        = 0; // Force to rebuild plan
             }
+
+            resize_sc_delays();
         }
 
-        void mb_compressor::ui_activated()
+        void mb_compressor::update_transfer_function(channel_t *c, const float *tr)
         {
-            size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
+            const size_t bytes  = meta::mb_compressor_metadata::FFT_MESH_POINTS * sizeof(float);
+            if (memcmp(c->vTrMem, tr, bytes) == 0)
+                return;
 
-            for (size_t i=0; i<channels; ++i)
+            dsp::copy(c->vTrMem, tr, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+            c->nSync           |= S_AMP_CURVE;
+            bIDisplayUpdate     = true;
+        }
+
+        void mb_compressor::ui_activated()
+        {
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c        = &vChannels[i];
+                c->nSync            = S_ALL;
 
                 for (size_t j=0; j<c->nPlanSize; ++j)
                 {
@@ -1399,52 +1679,82 @@ namespace lsp
             dsp::copy(&b->vBuffer[sample], data, count);
         }
 
-        void mb_compressor::process_input_mono(float *out, const float *in, size_t count)
+        void mb_compressor::mix_input(const float **dst, float * const *buf, const mix_src_t *src, size_t n, size_t count)
         {
-            if (in != NULL)
-                dsp::mul_k3(out, in, fInGain, count);
-            else
-                dsp::fill_zero(out, count);
-        }
+            const float *vl[3], *vr[3];
+            float vk[3];
+            const float gain    = (nMode == MBCM_MS) ? 0.5f * fInGain : fInGain;
 
-        void mb_compressor::process_input_stereo(float *l_out, float *r_out, const float *l_in, const float *r_in, size_t count)
-        {
+            // Collect audible sources, missing channel data is treated as silence
+            size_t items        = 0;
+            for (size_t i=0; i<n; ++i)
+            {
+                const mix_src_t *s  = &src[i];
+                if (s->fGain <= GAIN_AMP_M_INF_DB)
+                    continue;
+                if ((s->vData[0] == NULL) && ((nChannels < 2) || (s->vData[1] == NULL)))
+                    continue;
+
+                vl[items]           = (s->vData[0] != NULL) ? s->vData[0] : vZero;
+                vr[items]           = ((nChannels > 1) && (s->vData[1] != NULL)) ? s->vData[1] : vZero;
+                vk[items]           = s->fGain * gain;
+                ++items;
+            }
+
+            // Refer the source data directly if there is nothing to mix and no gain to apply
+            if (items == 0)
+            {
+                dst[0]              = vZero;
+                dst[1]              = vZero;
+                return;
+            }
+            else if ((nMode != MBCM_MS) && (items == 1) && (vk[0] == GAIN_AMP_0_DB))
+            {
+                dst[0]              = vl[0];
+                dst[1]              = vr[0];
+                return;
+            }
+
+            for (size_t i=0; i<nChannels; ++i)
+                dst[i]              = buf[i];
+
+            // Mix sources, apply input gain and convert to Mid/Side (if required) in one pass
             if (nMode == MBCM_MS)
             {
-                if (l_in != NULL)
-                {
-                    if (r_in != NULL)
-                    {
-                        dsp::lr_to_ms(l_out, r_out, l_in, r_in, count);
-                        dsp::mul_k2(l_out, fInGain, count);
-                        dsp::mul_k2(r_out, fInGain, count);
-                    }
-                    else
-                    {
-                        dsp::mul_k3(l_out, l_in, 0.5f * fInGain, count);
-                        dsp::fill_zero(r_out, count);
-                    }
-                }
-                else
+                switch (items)
                 {
-                    dsp::fill_zero(l_out, count);
-                    if (r_in != NULL)
-                        dsp::mul_k3(r_out, r_in, -0.5f * fInGain, count);
-                    else
-                        dsp::fill_zero(r_out, count);
+                    case 1:
+                        dsp::mix_copy2(buf[0], vl[0], vr[0], vk[0], vk[0], count);
+                        dsp::mix_copy2(buf[1], vl[0], vr[0], vk[0], -vk[0], count);
+                        break;
+                    default:
+                        dsp::mix_copy4(buf[0], vl[0], vr[0], vl[1], vr[1], vk[0], vk[0], vk[1], vk[1], count);
+                        dsp::mix_copy4(buf[1], vl[0], vr[0], vl[1], vr[1], vk[0], -vk[0], vk[1], -vk[1], count);
+                        if (items > 2)
+                        {
+                            dsp::mix_add2(buf[0], vl[2], vr[2], vk[2], vk[2], count);
+                            dsp::mix_add2(buf[1], vl[2], vr[2], vk[2], -vk[2], count);
+                        }
+                        break;
                 }
+                return;
             }
-            else
-            {
-                if (l_in != NULL)
-                    dsp::mul_k3(l_out, l_in, fInGain, count);
-                else
-                    dsp::fill_zero(l_out, count);
 
-                if (r_in != NULL)
-                    dsp::mul_k3(r_out, r_in, fInGain, count);
-                else
-                    dsp::fill_zero(r_out, count);
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                const float **v     = (i == 0) ? vl : vr;
+                switch (items)
+                {
+                    case 1:
+                        dsp::mul_k3(buf[i], v[0], vk[0], count);
+                        break;
+                    case 2:
+                        dsp::mix_copy2(buf[i], v[0], v[1], vk[0], vk[1], count);
+                        break;
+                    default:
+                        dsp::mix_copy3(buf[i], v[0], v[1], v[2], vk[0], vk[1], vk[2], count);
+                        break;
+                }
             }
         }
 
@@ -1454,45 +1764,313 @@ namespace lsp
             {
                 case SCT_INTERNAL: return (bSidechain) ? channel->vScBuffer : channel->vExtScBuffer;
                 case SCT_EXTERNAL: return channel->vExtScBuffer;
-                case SCT_LINK: return channel->vShmBuffer;
+                case SCT_LINK: return channel->vShmLink;
                 default: break;
             }
             return channel->vScBuffer;
         }
 
-        void mb_compressor::preprocess_channel_input(size_t count)
+        void mb_compressor::resize_sc_delays()
+        {
+            // Sidechain delays carry the lookahead compensation and, in the linear phase mode only,
+            // the crossover latency. Resizing reallocates the buffers, so it is done only when the
+            // sample rate or the crossover mode changes
+            const size_t max_lookahead  =
+                dspu::millis_to_samples(fSampleRate, meta::mb_compressor_metadata::LOOKAHEAD_MAX) +
+                meta::mb_compressor_metadata::OVERSAMPLING_LATENCY;
+
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                const size_t max_delay  = (enXOver == XOVER_LINEAR_PHASE) ?
+                    max_lookahead + (size_t(1) << c->nXOverRank) : max_lookahead;
+
+                for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
+                    c->vBands[j].sScDelay.init(max_delay);
+            }
+        }
+
+        void mb_compressor::update_delay(dspu::Delay *delay, size_t samples)
         {
-            const size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
+            // Zero-length delay line is not processed, drop the data it holds to not
+            // output the stale signal when the delay becomes non-zero again
+            if ((samples == 0) && (delay->get_delay() > 0))
+                delay->clear();
+            delay->set_delay(samples);
+        }
+
+        const float *mb_compressor::delay_input(channel_t *c, float *dst, size_t count)
+        {
+            if (c->sDelay.get_delay() <= 0)
+                return c->vInAnalyze;
+
+            c->sDelay.process(dst, c->vInAnalyze, count);
+            return dst;
+        }
+
+    #ifdef MB_COMPRESSOR_PROFILING
+        uint64_t mb_compressor::profile_clock()
+        {
+        #if defined(ARCH_X86)
+            return __rdtsc();
+        #else
+            struct timespec ts;
+            #ifdef CLOCK_MONOTONIC_RAW
+                clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+            #else
+                clock_gettime(CLOCK_MONOTONIC, &ts);
+            #endif /* CLOCK_MONOTONIC_RAW */
+            return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+        #endif /* ARCH_X86 */
+        }
+
+        void mb_compressor::reset_stage_time(stage_time_t *t)
+        {
+            t->nMin         = UINT64_MAX;
+            t->nMax         = 0;
+            t->nSum         = 0;
+            t->nCount       = 0;
+        }
 
-            // Process input buffers
-            if (channels > 1)
+        void mb_compressor::commit_stage_time(stage_time_t *t, uint64_t start)
+        {
+            const uint64_t time = profile_clock() - start;
+            t->nMin         = lsp_min(t->nMin, time);
+            t->nMax         = lsp_max(t->nMax, time);
+            t->nSum        += time;
+            ++t->nCount;
+        }
+
+        void mb_compressor::dump_stage_time(dspu::IStateDumper *v, const char *name, const stage_time_t *t)
+        {
+            v->begin_object(name, t, sizeof(stage_time_t));
+            {
+                v->write("nMin", (t->nCount > 0) ? t->nMin : 0);
+                v->write("nAvg", (t->nCount > 0) ? t->nSum / t->nCount : 0);
+                v->write("nMax", t->nMax);
+                v->write("nCount", t->nCount);
+                v->write("sUnit", MBC_PROFILE_UNIT);
+            }
+            v->end_object();
+        }
+    #endif /* MB_COMPRESSOR_PROFILING */
+
+        void mb_compressor::process_detector(comp_band_t *band, size_t count)
+        {
+            if (nOversampling <= 1)
+            {
+                band->sSC.process(vBuffer, const_cast<const float **>(vSc), count);
+                return;
+            }
+
+            // Run the detector at the oversampled rate to catch inter-sample peaks
+            for (size_t i=0; i<nChannels; ++i)
+                band->sOver[i].upsample(vOvsSc[i], vSc[i], count);
+            band->sSC.process(vOvsEnv, const_cast<const float **>(vOvsSc), count * nOversampling);
+
+            // Decimate the detector output back to the original sample rate keeping the peaks
+            const float *env    = vOvsEnv;
+            for (size_t i=0; i<count; ++i, env += nOversampling)
             {
-                channel_t *l = &vChannels[0];
-                channel_t *r = &vChannels[1];
+                float v             = env[0];
+                for (size_t j=1; j<nOversampling; ++j)
+                    v                   = lsp_max(v, env[j]);
+                vBuffer[i]          = v;
+            }
+        }
+
+        size_t mb_compressor::select_control_period(size_t sample_rate, float attack, float release)
+        {
+            // Keep enough control periods within the shortest time constant
+            const float samples = dspu::millis_to_samples(sample_rate, lsp_min(attack, release));
+            const float limit   = samples / meta::mb_compressor_metadata::CONTROL_PERIOD_DIV;
 
-                process_input_stereo(l->vInAnalyze, r->vInAnalyze, l->vIn, r->vIn, count);
-                process_input_stereo(l->vExtScBuffer, r->vExtScBuffer, l->vScIn, r->vScIn, count);
-                if (bUseShmLink)
-                    process_input_stereo(l->vShmBuffer, r->vShmBuffer, l->vShmIn, r->vShmIn, count);
+            size_t period       = 1;
+            while ((period < meta::mb_compressor_metadata::CONTROL_PERIOD_MAX) && (float(period * 2) <= limit))
+                period            <<= 1;
+
+            return period;
+        }
+
+        size_t mb_compressor::process_gain(comp_band_t *band, size_t count)
+        {
+            const size_t period = band->nCtlPeriod;
+            if (period <= 1)
+            {
+                band->sComp.process(band->vVCA, vEnv, vBuffer, count);
+                return count;
+            }
+
+            // Pick the peak level of each control period, the levels are stored in place
+            const size_t phase  = band->nCtlPhase;
+            size_t ticks        = 0;
+            for (size_t offset=0; offset < count; )
+            {
+                const size_t to_do  = lsp_min(period - band->nCtlPhase, count - offset);
+                band->fCtlPeak      = lsp_max(band->fCtlPeak, dsp::max(&vBuffer[offset], to_do));
+                band->nCtlPhase    += to_do;
+                offset             += to_do;
+
+                if (band->nCtlPhase >= period)
+                {
+                    vBuffer[ticks++]    = band->fCtlPeak;
+                    band->fCtlPeak      = 0.0f;
+                    band->nCtlPhase     = 0;
+                }
+            }
+
+            // Compute the gain at the control rate
+            if (ticks > 0)
+                band->sComp.process(vBuffer, vEnv, vBuffer, ticks);
+
+            // Reconstruct the VCA by interpolating the gain between the control points
+            for (size_t offset=0, tick=0, pos=phase; offset < count; )
+            {
+                const size_t to_do  = lsp_min(period - pos, count - offset);
+                const float delta   = (band->fCtlTo - band->fCtlFrom) / period;
+                dsp::lramp_set1(&band->vVCA[offset], band->fCtlFrom + delta * pos, band->fCtlFrom + delta * (pos + to_do), to_do);
+                pos                += to_do;
+                offset             += to_do;
+
+                if (pos >= period)
+                {
+                    band->fCtlFrom      = band->fCtlTo;
+                    band->fCtlTo        = vBuffer[tick++];
+                    pos                 = 0;
+                }
+            }
+
+            return ticks;
+        }
+
+        size_t mb_compressor::send_gain(const comp_band_t *band, size_t count)
+        {
+            // The gain reduction of the band is sent by each channel which selected band
+            // refers the band as a detector, makeup and muting are not applied yet
+            size_t sent         = 0;
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                if ((c->vShmGainOut == NULL) || (c->vBands[nGainLinkBand].pDetector != band))
+                    continue;
+
+                dsp::copy(c->vShmGainOut, band->vVCA, count);
+                sent               |= 1 << i;
+            }
+
+            return sent;
+        }
+
+        void mb_compressor::preprocess_channel_input(size_t count)
+        {
+            float *buf[2];
+            const float *sc[2], *link[2], *in[2];
+            mix_src_t src[3];
+
+            // Input signal
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                const channel_t *c  = &vChannels[i];
+                buf[i]              = c->vAnBuffer;
+                src[0].vData[i]     = c->vIn;
+            }
+            src[0].fGain        = GAIN_AMP_0_DB;
+            mix_input(in, buf, src, 1, count);
+
+            // Determine which sidechain streams are used by detectors, the internal sidechain
+            // is taken from the external sidechain stream if there is no sidechain input
+            const bool use_int  = (bSidechain) && (nScSources & SCF_INTERNAL);
+            const bool use_ext  = (nScSources & SCF_EXTERNAL) || ((!bSidechain) && (nScSources & SCF_INTERNAL));
+            const bool use_link = nScSources & SCF_LINK;
+
+            // Sidechain signal, it matches the input signal if there is no sidechain and both receive the same amount of link
+            const bool sc_as_in = (!bSidechain) && (sPremix.fLinkToSc == sPremix.fLinkToIn);
+            if (!use_ext)
+            {
+                sc[0]               = NULL;
+                sc[1]               = NULL;
+            }
+            else if (!sc_as_in)
+            {
+                for (size_t i=0; i<nChannels; ++i)
+                {
+                    const channel_t *c  = &vChannels[i];
+                    buf[i]              = c->vExtScBuffer;
+                    src[0].vData[i]     = c->vScIn;
+                    src[1].vData[i]     = c->vInData;
+                    src[2].vData[i]     = c->vShmIn;
+                }
+                src[0].fGain        = GAIN_AMP_0_DB;
+                src[1].fGain        = sPremix.fInToSc;
+                src[2].fGain        = sPremix.fLinkToSc;
+                mix_input(sc, buf, src, 3, count);
             }
             else
             {
-                channel_t *c = &vChannels[0];
-                process_input_mono(c->vInAnalyze, c->vIn, count);
-                process_input_mono(c->vExtScBuffer, c->vScIn, count);
-                if (bUseShmLink)
-                    process_input_mono(c->vShmBuffer, c->vShmIn, count);
+                sc[0]               = in[0];
+                sc[1]               = in[1];
             }
 
-            // Do frequency boost and input channel analysis
-            for (size_t i=0; i<channels; ++i)
+            // Shared memory link signal. The envelope-boosted link received over the processed link
+            // return is used as is, otherwise the link is mixed and boosted locally if it is used
+            // by detectors or sent over the processed link
+            const bool link_send    = vChannels[0].vShmProcOut != NULL;
+            bool link_ready         = true;
+            for (size_t i=0; i<nChannels; ++i)
+                link_ready             &= vChannels[i].vShmProcIn != NULL;
+
+            bool link_active    = false;
+            if (((use_link) || (link_send)) && (!link_ready))
+            {
+                for (size_t i=0; i<nChannels; ++i)
+                {
+                    const channel_t *c  = &vChannels[i];
+                    buf[i]              = c->vShmBuffer;
+                    src[0].vData[i]     = c->vShmIn;
+                    src[1].vData[i]     = c->vInData;
+                    src[2].vData[i]     = c->vScIn;
+                }
+                src[0].fGain        = GAIN_AMP_0_DB;
+                src[1].fGain        = sPremix.fInToLink;
+                src[2].fGain        = sPremix.fScToLink;
+                mix_input(link, buf, src, 3, count);
+                link_active         = (link[0] != vZero) || (link[1] != vZero);
+            }
+
+            // Reset the link boost filters if there is no more data from the link
+            if ((bLinkActive) && (!link_active))
+            {
+                for (size_t i=0; i<nChannels; ++i)
+                    vChannels[i].sEnvBoost[2].clear();
+            }
+            bLinkActive         = link_active;
+
+            // Do frequency boost and input channel analysis, the boost filters read directly from the source data
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c        = &vChannels[i];
-                if (c->vScBuffer != NULL)
+                c->vInAnalyze       = in[i];
+                if (use_int)
                     c->sEnvBoost[0].process(c->vScBuffer, c->vInAnalyze, count);
-                c->sEnvBoost[1].process(c->vExtScBuffer, c->vExtScBuffer, count);
-                if (bUseShmLink)
-                    c->sEnvBoost[2].process(c->vShmBuffer, c->vShmBuffer, count);
+                if (use_ext)
+                    c->sEnvBoost[1].process(c->vExtScBuffer, sc[i], count);
+
+                if (link_active)
+                {
+                    c->sEnvBoost[2].process(c->vShmBuffer, link[i], count);
+                    c->vShmLink         = c->vShmBuffer;
+                }
+                else
+                    c->vShmLink         = (link_ready) ? c->vShmProcIn : vZero;
+
+                // Publish the boosted link and advance the processed link pointers
+                if (c->vShmProcOut != NULL)
+                {
+                    dsp::copy(c->vShmProcOut, c->vShmLink, count);
+                    c->vShmProcOut     += count;
+                }
+                if (c->vShmProcIn != NULL)
+                    c->vShmProcIn      += count;
             }
         }
 
@@ -1506,6 +2084,7 @@ namespace lsp
             float * const link_buf  = sPremix.vLink[channel];
 
             c->vIn                  = in_buf;
+            c->vInData              = in_buf;
             c->vOut                 = out_buf;
             c->vScIn                = sc_buf;
             c->vShmIn               = link_buf;
@@ -1518,106 +2097,152 @@ namespace lsp
             if (sPremix.vLink[channel] != NULL)
                 sPremix.vLink[channel] += count;
 
-            // Perform transformation
-            if (bSidechain)
+            // (Sc, Link) -> In, the mixed input is also used by the dry chain and metering.
+            // Sidechain and link streams are mixed directly by preprocess_channel_input()
+            const bool sc_to_in     = (bSidechain) && (sc_buf != NULL) && (sPremix.fScToIn > GAIN_AMP_M_INF_DB);
+            const bool link_to_in   = (link_buf != NULL) && (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB);
+
+            if (sc_to_in)
             {
-                // (Sc, Link) -> In
-                if ((sc_buf != NULL) && (sPremix.fScToIn > GAIN_AMP_M_INF_DB))
-                {
-                    c->vIn              = sPremix.vTmpIn[channel];
+                c->vIn              = sPremix.vTmpIn[channel];
+                if (link_to_in)
+                    dsp::mix_copy3(c->vIn, in_buf, sc_buf, link_buf, GAIN_AMP_0_DB, sPremix.fScToIn, sPremix.fLinkToIn, count);
+                else
                     dsp::fmadd_k4(c->vIn, in_buf, sc_buf, sPremix.fScToIn, count);
+            }
+            else if (link_to_in)
+            {
+                c->vIn              = sPremix.vTmpIn[channel];
+                dsp::fmadd_k4(c->vIn, in_buf, link_buf, sPremix.fLinkToIn, count);
+            }
+        }
 
-                    if ((link_buf != NULL) && (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB))
-                        dsp::fmadd_k3(c->vIn, link_buf, sPremix.fLinkToIn, count);
-                }
-                else if ((link_buf != NULL) && (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB))
+        void mb_compressor::apply_vca_modern(size_t count)
+        {
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                c->vInDelayed       = delay_input(c, c->vInBuffer, count); // Apply delay to compensate lookahead feature
+
+                // Single band is an amplifier, apply the VCA directly
+                comp_band_t *b      = c->vPlan[0];
+                if (c->nPlanSize <= 1)
                 {
-                    c->vIn              = sPremix.vTmpIn[channel];
-                    dsp::fmadd_k4(c->vIn, in_buf, link_buf, sPremix.fLinkToIn, count);
+                    dsp::mul3(c->vBuffer, c->vInDelayed, b->pDetector->vVCA, count);
+                    continue;
                 }
 
-                // (In, Link) -> Sc
-                if (sPremix.fInToSc > GAIN_AMP_M_INF_DB)
-                {
-                    c->vScIn            = sPremix.vTmpSc[channel];
-                    if (sc_buf != NULL)
-                        dsp::fmadd_k4(c->vScIn, sc_buf, in_buf, sPremix.fInToSc, count);
-                    else
-                        dsp::mul_k3(c->vScIn, in_buf, sPremix.fInToSc, count);
+                // Process first band
+                sFilters.process(b->nFilterID, c->vBuffer, c->vInDelayed, b->pDetector->vVCA, count);
 
-                    if ((link_buf != NULL) && (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB))
-                        dsp::fmadd_k3(c->vScIn, link_buf, sPremix.fLinkToSc, count);
-                }
-                else if ((link_buf != NULL) && (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB))
+                // Process other bands
+                for (size_t j=1; j<c->nPlanSize; ++j)
                 {
-                    c->vScIn            = sPremix.vTmpSc[channel];
-                    if (sc_buf != NULL)
-                        dsp::fmadd_k4(c->vScIn, sc_buf, link_buf, sPremix.fLinkToSc, count);
-                    else
-                        dsp::mul_k3(c->vScIn, link_buf, sPremix.fLinkToSc, count);
+                    b                   = c->vPlan[j];
+                    sFilters.process(b->nFilterID, c->vBuffer, c->vBuffer, b->pDetector->vVCA, count);
                 }
+            }
+        }
 
-                // (In, Sc) -> Link
-                if (sPremix.fInToLink > GAIN_AMP_M_INF_DB)
-                {
-                    c->vShmIn           = sPremix.vTmpLink[channel];
-                    if (link_buf != NULL)
-                        dsp::fmadd_k4(c->vShmIn, link_buf, in_buf, sPremix.fInToLink, count);
-                    else
-                        dsp::mul_k3(c->vShmIn, in_buf, sPremix.fInToLink, count);
+        void mb_compressor::apply_vca_classic(size_t count)
+        {
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                // Originally, there is no signal
+                c->vInDelayed       = delay_input(c, c->vInBuffer, count); // Apply delay to compensate lookahead feature
 
-                    if ((sc_buf != NULL) && (sPremix.fScToLink > GAIN_AMP_M_INF_DB))
-                        dsp::fmadd_k3(c->vShmIn, sc_buf, sPremix.fScToLink, count);
+                // Single band does not need any filtering
+                const size_t last   = c->nPlanSize - 1;
+                comp_band_t *b      = c->vPlan[0];
+                if (last <= 0)
+                {
+                    dsp::mul3(c->vBuffer, c->vInDelayed, b->pDetector->vVCA, count);
+                    continue;
                 }
-                else if ((sc_buf != NULL) && (sPremix.fScToLink > GAIN_AMP_M_INF_DB))
+
+                // First step
+                // Filter frequencies from input
+                b->sPassFilter.process(vEnv, c->vInDelayed, count);
+                // Apply VCA gain and add to the channel buffer
+                dsp::mul3(c->vBuffer, vEnv, b->pDetector->vVCA, count);
+                // Filter frequencies from input
+                b->sRejFilter.process(vBuffer, c->vInDelayed, count);
+
+                // All other steps except the last one
+                for (size_t j=1; j<last; ++j)
                 {
-                    c->vShmIn           = sPremix.vTmpLink[channel];
-                    if (link_buf != NULL)
-                        dsp::fmadd_k4(c->vShmIn, link_buf, sc_buf, sPremix.fScToLink, count);
-                    else
-                        dsp::mul_k3(c->vShmIn, sc_buf, sPremix.fScToLink, count);
+                    b                   = c->vPlan[j];
+                    // Process the signal with all-pass
+                    b->sAllFilter.process(c->vBuffer, c->vBuffer, count);
+                    // Filter frequencies from input
+                    b->sPassFilter.process(vEnv, vBuffer, count);
+                    // Apply VCA gain and add to the channel buffer
+                    dsp::fmadd3(c->vBuffer, vEnv, b->pDetector->vVCA, count);
+                    // Filter frequencies from input
+                    b->sRejFilter.process(vBuffer, vBuffer, count);
                 }
+
+                // Last step: all filters of the last band are pass-through, the rest of
+                // the signal gets the VCA gain and is added to the channel buffer as is
+                b                   = c->vPlan[last];
+                dsp::fmadd3(c->vBuffer, vBuffer, b->pDetector->vVCA, count);
             }
-            else
+        }
+
+        void mb_compressor::apply_vca_linear_phase(size_t count)
+        {
+            for (size_t i=0; i<nChannels; ++i)
             {
-                // Link -> (In, Sc)
-                if (link_buf != NULL)
+                channel_t *c        = &vChannels[i];
+
+                // Single band does not need the crossover, apply the VCA directly. The signal still
+                // gets the crossover latency if other channels use the crossover
+                if (c->nPlanSize <= 1)
                 {
-                    // Link -> In
-                    if (sPremix.fLinkToIn > GAIN_AMP_M_INF_DB)
-                    {
-                        c->vIn          = sPremix.vTmpIn[channel];
-                        dsp::fmadd_k4(c->vIn, in_buf, link_buf, sPremix.fLinkToIn, count);
-                    }
-                    // Link -> Sc
-                    if (sPremix.fLinkToSc > GAIN_AMP_M_INF_DB)
+                    c->vInDelayed       = delay_input(c, c->vInBuffer, count);
+                    if (c->sXOverDelay.get_delay() > 0)
                     {
-                        c->vScIn        = sPremix.vTmpSc[channel];
-                        if (sc_buf != NULL)
-                            dsp::fmadd_k4(c->vScIn, sc_buf, link_buf, sPremix.fLinkToSc, count);
-                        else
-                            dsp::mul_k3(c->vScIn, link_buf, sPremix.fLinkToSc, count);
+                        c->sXOverDelay.process(c->vInBuffer, c->vInDelayed, count);
+                        c->vInDelayed       = c->vInBuffer;
                     }
+                    dsp::mul3(c->vBuffer, c->vInDelayed, c->vPlan[0]->pDetector->vVCA, count);
+                    c->bXOver           = false;
+                    continue;
                 }
 
-                // In -> Link
-                if (sPremix.fInToLink > GAIN_AMP_M_INF_DB)
+                // Drop the data left in the crossover since it was used last time
+                if (!c->bXOver)
                 {
-                    c->vShmIn       = sPremix.vTmpLink[channel];
-                    if (link_buf != NULL)
-                        dsp::fmadd_k4(c->vShmIn, link_buf, in_buf, sPremix.fInToLink, count);
-                    else
-                        dsp::mul_k3(c->vShmIn, in_buf, sPremix.fInToLink, count);
+                    c->sFFTXOver.clear();
+                    c->bXOver           = true;
+                }
+
+                // Apply delay to compensate lookahead feature
+                const float *in     = delay_input(c, c->vBuffer, count);
+                // Apply delay to unprocessed signal to compensate lookahead + crossover delay
+                c->sXOverDelay.process(c->vInBuffer, in, count);
+                c->vInDelayed       = c->vInBuffer;
+                c->sFFTXOver.process(in, count);
+
+                // First step
+                comp_band_t *b      = c->vPlan[0];
+                dsp::mul3(c->vBuffer, b->pDetector->vVCA, b->vBuffer, count);
+
+                // All other steps
+                for (size_t j=1; j<c->nPlanSize; ++j)
+                {
+                    b                   = c->vPlan[j];
+                    dsp::fmadd3(c->vBuffer, b->pDetector->vVCA, b->vBuffer, count);
                 }
             }
         }
 
         void mb_compressor::process(size_t samples)
         {
-            size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
-
             // Bind input signal
-            for (size_t i=0; i<channels; ++i)
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c        = &vChannels[i];
 
@@ -1629,6 +2254,18 @@ namespace lsp
                 core::AudioBuffer *shm_buf  = (c->pShmIn != NULL) ? c->pShmIn->buffer<core::AudioBuffer>() : NULL;
                 if ((shm_buf != NULL) && (shm_buf->active()))
                     sPremix.vLink[i]    = shm_buf->buffer();
+
+                core::AudioBuffer *gain_out = (c->pShmGainOut != NULL) ? c->pShmGainOut->buffer<core::AudioBuffer>() : NULL;
+                c->vShmGainOut      = ((gain_out != NULL) && (gain_out->active())) ? gain_out->buffer() : NULL;
+
+                core::AudioBuffer *gain_in  = (c->pShmGainIn != NULL) ? c->pShmGainIn->buffer<core::AudioBuffer>() : NULL;
+                c->vShmGainIn       = ((gain_in != NULL) && (gain_in->active())) ? gain_in->buffer() : NULL;
+
+                core::AudioBuffer *proc_in  = (c->pShmProcIn != NULL) ? c->pShmProcIn->buffer<core::AudioBuffer>() : NULL;
+                c->vShmProcIn       = ((proc_in != NULL) && (proc_in->active())) ? proc_in->buffer() : NULL;
+
+                core::AudioBuffer *proc_out = (c->pShmProcOut != NULL) ? c->pShmProcOut->buffer<core::AudioBuffer>() : NULL;
+                c->vShmProcOut      = ((proc_out != NULL) && (proc_out->active())) ? proc_out->buffer() : NULL;
             }
 
             // Do processing
@@ -1638,7 +2275,8 @@ namespace lsp
                 const size_t to_process = lsp_min(MBC_BUFFER_SIZE, samples - offset);
 
                 // Premix and measure input signal level
-                for (size_t i=0; i<channels; ++i)
+                MBC_PROFILE_START(t_premix);
+                for (size_t i=0; i<nChannels; ++i)
                 {
                     channel_t *c        = &vChannels[i];
 
@@ -1646,154 +2284,134 @@ namespace lsp
                     const float level   = dsp::abs_max(c->vIn, to_process) * fInGain;
                     c->pInLvl->set_value(level);
                 }
+                MBC_PROFILE_COMMIT(&vStageTime[PS_PREMIX], t_premix);
 
                 // Pre-process channel data
+                MBC_PROFILE_START(t_preprocess);
                 preprocess_channel_input(to_process);
+                MBC_PROFILE_COMMIT(&vStageTime[PS_PREPROCESS], t_preprocess);
 
                 // MAIN PLUGIN STUFF
-                for (size_t i=0; i<channels; ++i)
+                size_t gain_sent    = 0; // Channels which have sent the gain reduction to the gain link
+                for (size_t i=0; i<nChannels; ++i)
                 {
                     channel_t *c        = &vChannels[i];
 
                     for (size_t j=0; j<c->nPlanSize; ++j)
                     {
                         comp_band_t *b      = c->vPlan[j];
-
-                        // Prepare sidechain signal with band equalizers
-                        b->sEQ[0].process(vSc[0], select_buffer(b, &vChannels[0]), to_process);
-                        if (channels > 1)
-                            b->sEQ[1].process(vSc[1], select_buffer(b, &vChannels[1]), to_process);
-
-                        // Preprocess VCA signal
-                        b->sSC.process(vBuffer, const_cast<const float **>(vSc), to_process); // Band now contains processed by sidechain signal
-                        b->sScDelay.process(vBuffer, vBuffer, b->fScPreamp, to_process); // Apply sidechain preamp and lookahead delay
-
-                        if (b->bEnabled)
+                        if (b->pDetector != b)
                         {
-                            b->sComp.process(b->vVCA, vEnv, vBuffer, to_process); // Output
-                            dsp::mul_k2(b->vVCA, b->fMakeup, to_process); // Apply makeup gain
-
-                            // Output curve level
-                            float lvl = dsp::abs_max(vEnv, to_process);
-                            b->pEnvLvl->set_value(lvl);
-                            b->pMeterGain->set_value(b->sComp.reduction(lvl));
-                            lvl = b->sComp.curve(lvl) * b->fMakeup;
-                            b->pCurveLvl->set_value(lvl);
-
-                            // Remember last envelope level and buffer level
-                            b->fGainLevel   = b->vVCA[to_process-1];
-
-                            // Check muting option
-                            if (b->bMute)
-                                dsp::fill(b->vVCA, GAIN_AMP_M_36_DB, to_process);
+                            // VCA has been already computed by the leading band of the link group
+                            const comp_band_t *d    = b->pDetector;
+                            b->fGainLevel   = d->fGainLevel;
+                            b->fEnvLevel    = d->fEnvLevel;
+                            b->fCurveLevel  = d->fCurveLevel;
+                            b->fReduction   = d->fReduction;
+                            continue;
                         }
-                        else
+                        if (!b->bEnabled)
                         {
+                            // Disabled band does not need the sidechain processing
                             dsp::fill(b->vVCA, (b->bMute) ? GAIN_AMP_M_36_DB : GAIN_AMP_0_DB, to_process);
                             b->fGainLevel   = GAIN_AMP_0_DB;
+                            continue;
                         }
-                    }
 
-                    // Output curve parameters for disabled compressors
-                    for (size_t i=0; i<meta::mb_compressor_metadata::BANDS_MAX; ++i)
-                    {
-                        comp_band_t *b      = &c->vBands[i];
-                        if (b->bEnabled)
+                        if (b->nScType == SCT_LINK_GAIN)
+                        {
+                            // Use the gain reduction received from another instance instead of own detector
+                            if (c->vShmGainIn != NULL)
+                                dsp::copy(b->vVCA, c->vShmGainIn, to_process);
+                            else
+                                dsp::fill(b->vVCA, GAIN_AMP_0_DB, to_process);
+
+                            b->fEnvLevel    = 0.0f;
+                            b->fCurveLevel  = 0.0f;
+                            b->fReduction   = b->vVCA[to_process-1];
+                            gain_sent      |= send_gain(b, to_process);
+                            dsp::mul_k2(b->vVCA, b->fMakeup, to_process);
+                            b->fGainLevel   = b->vVCA[to_process-1];
+                            if (b->bMute)
+                                dsp::fill(b->vVCA, GAIN_AMP_M_36_DB, to_process);
                             continue;
+                        }
 
-                        b->pEnvLvl->set_value(0.0f);
-                        b->pCurveLvl->set_value(0.0f);
-                        b->pMeterGain->set_value(GAIN_AMP_0_DB);
+                        // Prepare sidechain signal with band equalizers
+                        MBC_PROFILE_START(t_sc);
+                        b->sEQ[0].process(vSc[0], select_buffer(b, &vChannels[0]), to_process);
+                        if (nChannels > 1)
+                            b->sEQ[1].process(vSc[1], select_buffer(b, &vChannels[1]), to_process);
+
+                        // Preprocess VCA signal
+                        process_detector(b, to_process); // Band now contains processed by sidechain signal
+                        if (b->sScDelay.get_delay() > 0)
+                            b->sScDelay.process(vBuffer, vBuffer, b->fScPreamp, to_process); // Apply sidechain preamp and lookahead delay
+                        else if (b->fScPreamp != GAIN_AMP_0_DB)
+                            dsp::mul_k2(vBuffer, b->fScPreamp, to_process); // Apply sidechain preamp only
+                        MBC_PROFILE_COMMIT(&b->sScTime, t_sc);
+
+                        MBC_PROFILE_START(t_comp);
+                        const size_t env_count = process_gain(b, to_process); // Output
+                        gain_sent      |= send_gain(b, to_process); // Send the gain reduction to the gain link
+                        dsp::mul_k2(b->vVCA, b->fMakeup, to_process); // Apply makeup gain
+                        MBC_PROFILE_COMMIT(&b->sCompTime, t_comp);
+
+                        // Compute curve level
+                        if (env_count > 0)
+                            b->fEnvLevel    = dsp::abs_max(vEnv, env_count);
+                        b->fReduction   = b->sComp.reduction(b->fEnvLevel);
+                        b->fCurveLevel  = b->sComp.curve(b->fEnvLevel) * b->fMakeup;
+
+                        // Remember last envelope level and buffer level
+                        b->fGainLevel   = b->vVCA[to_process-1];
+
+                        // Check muting option
+                        if (b->bMute)
+                            dsp::fill(b->vVCA, GAIN_AMP_M_36_DB, to_process);
                     }
-                }
 
-                // Here, we apply VCA to input signal dependent on the input
-                if (enXOver == XOVER_MODERN) // 'Modern' mode
-                {
-                    // Apply VCA control
-                    for (size_t i=0; i<channels; ++i)
+                    // Send unity gain if the selected band did not send the gain reduction, advance the gain links
+                    if (c->vShmGainOut != NULL)
                     {
-                        channel_t *c        = &vChannels[i];
-                        c->sDelay.process(c->vInBuffer, c->vInAnalyze, to_process); // Apply delay to compensate lookahead feature
-
-                        // Process first band
-                        comp_band_t *b      = c->vPlan[0];
-                        sFilters.process(b->nFilterID, c->vBuffer, c->vInBuffer, b->vVCA, to_process);
-
-                        // Process other bands
-                        for (size_t j=1; j<c->nPlanSize; ++j)
-                        {
-                            b                   = c->vPlan[j];
-                            sFilters.process(b->nFilterID, c->vBuffer, c->vBuffer, b->vVCA, to_process);
-                        }
+                        if (!(gain_sent & (1 << i)))
+                            dsp::fill(c->vShmGainOut, GAIN_AMP_0_DB, to_process);
+                        c->vShmGainOut     += to_process;
                     }
-                }
-                else if (enXOver == XOVER_CLASSIC) // 'Classic' mode
-                {
-                    // Apply VCA control
-                    for (size_t i=0; i<channels; ++i)
-                    {
-                        channel_t *c        = &vChannels[i];
-
-                        // Originally, there is no signal
-                        c->sDelay.process(c->vInBuffer, c->vInAnalyze, to_process); // Apply delay to compensate lookahead feature, store into vBuffer
+                    if (c->vShmGainIn != NULL)
+                        c->vShmGainIn      += to_process;
 
-                        // First step
-                        comp_band_t *b      = c->vPlan[0];
-                        // Filter frequencies from input
-                        b->sPassFilter.process(vEnv, c->vInBuffer, to_process);
-                        // Apply VCA gain and add to the channel buffer
-                        dsp::mul3(c->vBuffer, vEnv, b->vVCA, to_process);
-                        // Filter frequencies from input
-                        b->sRejFilter.process(vBuffer, c->vInBuffer, to_process);
-
-                        // All other steps
-                        for (size_t j=1; j<c->nPlanSize; ++j)
+                    // Output curve parameters
+                    for (size_t j=0; j<meta::mb_compressor_metadata::BANDS_MAX; ++j)
+                    {
+                        comp_band_t *b      = &c->vBands[j];
+                        if (b->bEnabled)
                         {
-                            b                   = c->vPlan[j];
-                            // Process the signal with all-pass
-                            b->sAllFilter.process(c->vBuffer, c->vBuffer, to_process);
-                            // Filter frequencies from input
-                            b->sPassFilter.process(vEnv, vBuffer, to_process);
-                            // Apply VCA gain and add to the channel buffer
-                            dsp::fmadd3(c->vBuffer, vEnv, b->vVCA, to_process);
-                            // Filter frequencies from input
-                            b->sRejFilter.process(vBuffer, vBuffer, to_process);
+                            b->pEnvLvl->set_value(b->fEnvLevel);
+                            b->pCurveLvl->set_value(b->fCurveLevel);
+                            b->pMeterGain->set_value(b->fReduction);
                         }
-                    }
-                }
-                else // enXOver == XOVER_LINEAR_PHASE
-                {
-                    // Apply VCA control
-                    for (size_t i=0; i<channels; ++i)
-                    {
-                        channel_t *c        = &vChannels[i];
-
-                        // Apply delay to compensate lookahead feature
-                        c->sDelay.process(c->vBuffer, c->vInAnalyze, to_process);
-                        // Apply delay to unprocessed signal to compensate lookahead + crossover delay
-                        c->sXOverDelay.process(c->vInBuffer, c->vBuffer, to_process);
-                        c->sFFTXOver.process(c->vBuffer, to_process);
-
-                        // First step
-                        comp_band_t *b      = c->vPlan[0];
-                        dsp::mul3(c->vBuffer, b->vVCA, b->vBuffer, to_process);
-
-                        // All other steps
-                        for (size_t j=1; j<c->nPlanSize; ++j)
+                        else
                         {
-                            b                   = c->vPlan[j];
-                            dsp::fmadd3(c->vBuffer, b->vVCA, b->vBuffer, to_process);
+                            b->pEnvLvl->set_value(0.0f);
+                            b->pCurveLvl->set_value(0.0f);
+                            b->pMeterGain->set_value(GAIN_AMP_0_DB);
                         }
                     }
                 }
 
+                // Here, we apply VCA to input signal dependent on the crossover mode
+                MBC_PROFILE_START(t_xover);
+                (this->*pApplyVCA)(to_process);
+                MBC_PROFILE_COMMIT(&vStageTime[PS_XOVER], t_xover);
+
                 // MAIN PLUGIN STUFF END
 
                 // Do input and output channel analysis
                 if (sAnalyzer.activity())
                 {
-                    for (size_t i=0; i<channels; ++i)
+                    MBC_PROFILE_START(t_analyzer);
+                    for (size_t i=0; i<nChannels; ++i)
                     {
                         channel_t *c        = &vChannels[i];
                         vAnalyze[c->nAnInChannel]   = c->vInAnalyze;
@@ -1801,38 +2419,56 @@ namespace lsp
                     }
 
                     sAnalyzer.process(vAnalyze, to_process);
+                    MBC_PROFILE_COMMIT(&vStageTime[PS_ANALYZER], t_analyzer);
                 }
 
                 // Post-process data (if needed)
                 if (nMode == MBCM_MS)
                 {
                     dsp::ms_to_lr(vChannels[0].vBuffer, vChannels[1].vBuffer, vChannels[0].vBuffer, vChannels[1].vBuffer, to_process);
-                    dsp::ms_to_lr(vChannels[0].vInBuffer, vChannels[1].vInBuffer, vChannels[0].vInBuffer, vChannels[1].vInBuffer, to_process);
+                    if (fDryGain != 0.0f)
+                    {
+                        dsp::ms_to_lr(vChannels[0].vInBuffer, vChannels[1].vInBuffer, vChannels[0].vInDelayed, vChannels[1].vInDelayed, to_process);
+                        vChannels[0].vInDelayed     = vChannels[0].vInBuffer;
+                        vChannels[1].vInDelayed     = vChannels[1].vInBuffer;
+                    }
                 }
 
                 // Final metering
-                for (size_t i=0; i<channels; ++i)
+                for (size_t i=0; i<nChannels; ++i)
                 {
                     channel_t *c        = &vChannels[i];
 
-                    // Apply dry/wet balance
-                    if (enXOver == XOVER_MODERN)
-                        dsp::mix2(c->vBuffer, c->vInBuffer, fWetGain, fDryGain, to_process);
-                    else if (enXOver == XOVER_CLASSIC)
+                    // Apply dry/wet balance, the 'classic' mode needs phase compensation of the dry signal
+                    MBC_PROFILE_START(t_metering);
+                    if (fDryGain != 0.0f)
                     {
-                        c->sDryEq.process(vBuffer, c->vInBuffer, to_process);
-                        dsp::mix2(c->vBuffer, vBuffer, fWetGain, fDryGain, to_process);
+                        const float *dry    = c->vInDelayed;
+                        if (enXOver == XOVER_CLASSIC)
+                        {
+                            c->sDryEq.process(vBuffer, c->vInDelayed, to_process);
+                            dry                 = vBuffer;
+                        }
+                        dsp::mix2(c->vBuffer, dry, fWetGain, fDryGain, to_process);
                     }
-                    else // enXOver == XOVER_LINEAR_PHASE
-                        dsp::mix2(c->vBuffer, c->vInBuffer, fWetGain, fDryGain, to_process);
+                    else if (fWetGain != GAIN_AMP_0_DB)
+                        dsp::mul_k2(c->vBuffer, fWetGain, to_process); // Fully wet signal does not need the dry path
 
                     // Compute output level
                     float level         = dsp::abs_max(c->vBuffer, to_process);
                     c->pOutLvl->set_value(level);
+                    MBC_PROFILE_COMMIT(&vStageTime[PS_METERING], t_metering);
 
                     // Apply bypass
-                    c->sDryDelay.process(vBuffer, c->vIn, to_process);
-                    c->sBypass.process(c->vOut, vBuffer, c->vBuffer, to_process);
+                    MBC_PROFILE_START(t_bypass);
+                    const float *in     = c->vIn;
+                    if (c->sDryDelay.get_delay() > 0)
+                    {
+                        c->sDryDelay.process(vBuffer, c->vIn, to_process);
+                        in                  = vBuffer;
+                    }
+                    c->sBypass.process(c->vOut, in, c->vBuffer, to_process);
+                    MBC_PROFILE_COMMIT(&vStageTime[PS_BYPASS], t_bypass);
                 }
                 offset     += to_process;
             }
@@ -1840,7 +2476,8 @@ namespace lsp
             sCounter.submit(samples);
 
             // Output FFT curves for each channel
-            for (size_t i=0; i<channels; ++i)
+            MBC_PROFILE_START(t_mesh);
+            for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c     = &vChannels[i];
 
@@ -1859,7 +2496,8 @@ namespace lsp
                             sFilters.freq_chart(b->nFilterID, vTr, vFreqs, b->fGainLevel, meta::mb_compressor_metadata::FFT_MESH_POINTS);
                             dsp::pcomplex_mul2(c->vTr, vTr, meta::mb_compressor_metadata::FFT_MESH_POINTS);
                         }
-                        dsp::pcomplex_mod(c->vTrMem, c->vTr, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+                        dsp::pcomplex_mod(vTr, c->vTr, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+                        update_transfer_function(c, vTr);
                     }
                     else if (enXOver == XOVER_CLASSIC)
                     {
@@ -1888,7 +2526,7 @@ namespace lsp
                             else
                                 dsp::fmadd_k3(c->vTr, b->vTr, b->fGainLevel, meta::mb_compressor_metadata::FFT_MESH_POINTS);
                         }
-                        dsp::copy(c->vTrMem, c->vTr, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+                        update_transfer_function(c, c->vTr);
                     }
                     else // enXOver == XOVER_LINEAR_PHASE
                     {
@@ -1907,7 +2545,7 @@ namespace lsp
                             else
                                 dsp::fmadd_k3(c->vTr, b->vTr, b->fGainLevel, meta::mb_compressor_metadata::FFT_MESH_POINTS);
                         }
-                        dsp::copy(c->vTrMem, c->vTr, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+                        update_transfer_function(c, c->vTr);
                     }
                 }
 
@@ -2016,20 +2654,34 @@ namespace lsp
                         mesh->data(2, 0);
                 }
 
-                // Output Channel curve
-                mesh            = (c->pAmpGraph != NULL) ? c->pAmpGraph->buffer<plug::mesh_t>() : NULL;
-                if ((mesh != NULL) && (mesh->isEmpty()))
+                // Output Channel curve only if it has changed
+                if (c->nSync & S_AMP_CURVE)
                 {
-                    // Calculate amplitude (modulo)
-                    dsp::copy(mesh->pvData[0], vFreqs, meta::mb_compressor_metadata::FFT_MESH_POINTS);
-                    dsp::copy(mesh->pvData[1], c->vTrMem, meta::mb_compressor_metadata::FFT_MESH_POINTS);
-                    mesh->data(2, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+                    mesh            = (c->pAmpGraph != NULL) ? c->pAmpGraph->buffer<plug::mesh_t>() : NULL;
+                    if ((mesh != NULL) && (mesh->isEmpty()))
+                    {
+                        // Calculate amplitude (modulo)
+                        dsp::copy(mesh->pvData[0], vFreqs, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+                        dsp::copy(mesh->pvData[1], c->vTrMem, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+                        mesh->data(2, meta::mb_compressor_metadata::FFT_MESH_POINTS);
+                        c->nSync           &= ~size_t(S_AMP_CURVE);
+                    }
                 }
             } // for channel
+            MBC_PROFILE_COMMIT(&vStageTime[PS_MESH], t_mesh);
 
-            // Request for redraw
-            if ((pWrapper != NULL) && (sCounter.fired()))
+            // Request for redraw only if the inline display content has changed
+            const bool bypassing = vChannels[0].sBypass.bypassing();
+            if (bypassing != bIDisplayBypass)
+            {
+                bIDisplayBypass     = bypassing;
+                bIDisplayUpdate     = true;
+            }
+            if ((pWrapper != NULL) && (sCounter.fired()) && (bIDisplayUpdate))
+            {
                 pWrapper->query_display_draw();
+                bIDisplayUpdate     = false;
+            }
 
             sCounter.commit();
         }
@@ -2081,16 +2733,41 @@ namespace lsp
             }
 
             // Allocate buffer: f, x, y, tr
-            pIDisplay           = core::IDBuffer::reuse(pIDisplay, 4, width+2);
-            core::IDBuffer *b   = pIDisplay;
+            core::IDBuffer *b   = core::IDBuffer::reuse(pIDisplay, 4, width+2);
             if (b == NULL)
+            {
+                pIDisplay           = NULL;
                 return false;
+            }
 
-            // Initialize mesh
-            b->v[0][0]          = SPEC_FREQ_MIN*0.5f;
-            b->v[0][width+1]    = SPEC_FREQ_MAX*2.0f;
-            b->v[3][0]          = 1.0f;
-            b->v[3][width+1]    = 1.0f;
+            // Initialize mesh, mesh indexes, frequencies and horizontal coordinates depend on the width only
+            if ((b != pIDisplay) || (nIDisplayWidth != width))
+            {
+                uint32_t *idx       = static_cast<uint32_t *>(realloc(vIDisplayIdx, width * sizeof(uint32_t)));
+                if (idx == NULL)
+                {
+                    pIDisplay           = b;
+                    nIDisplayWidth      = 0;
+                    return false;
+                }
+                vIDisplayIdx        = idx;
+
+                b->v[0][0]          = SPEC_FREQ_MIN*0.5f;
+                b->v[0][width+1]    = SPEC_FREQ_MAX*2.0f;
+                b->v[3][0]          = 1.0f;
+                b->v[3][width+1]    = 1.0f;
+
+                for (size_t j=0; j<width; ++j)
+                {
+                    idx[j]              = (j*meta::mb_compressor_metadata::MESH_POINTS)/width;
+                    b->v[0][j+1]        = vFreqs[idx[j]];
+                }
+
+                dsp::fill(b->v[1], 0.0f, width+2);
+                dsp::axis_apply_log1(b->v[1], b->v[0], zx, dx, width+2);
+            }
+            pIDisplay           = b;
+            nIDisplayWidth      = width;
 
             static const uint32_t c_colors[] =
             {
@@ -2113,15 +2790,9 @@ namespace lsp
                 channel_t *c    = &vChannels[i];
 
                 for (size_t j=0; j<width; ++j)
-                {
-                    size_t k        = (j*meta::mb_compressor_metadata::MESH_POINTS)/width;
-                    b->v[0][j+1]    = vFreqs[k];
-                    b->v[3][j+1]    = c->vTrMem[k];
-                }
+                    b->v[3][j+1]    = c->vTrMem[vIDisplayIdx[j]];
 
-                dsp::fill(b->v[1], 0.0f, width+2);
                 dsp::fill(b->v[2], height, width+2);
-                dsp::axis_apply_log1(b->v[1], b->v[0], zx, dx, width+2);
                 dsp::axis_apply_log1(b->v[2], b->v[3], zy, dy, width+2);
 
                 // Draw mesh
@@ -2137,21 +2808,26 @@ namespace lsp
         {
             plug::Module::dump(v);
 
-            size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
-
             v->write_object("sAnalyzer", &sAnalyzer);
             v->write_object("sFilters", &sFilters);
             v->write_object("sCounter", &sCounter);
             v->write("nMode", nMode);
+            v->write("nChannels", nChannels);
             v->write("bSidechain", bSidechain);
             v->write("bEnvUpdate", bEnvUpdate);
-            v->write("bUseShmLink", bUseShmLink);
+            v->write("nScSources", nScSources);
+            v->write("bLinkActive", bLinkActive);
+            v->write("nGainLinkBand", nGainLinkBand);
             v->write("enXOver", enXOver);
             v->write("bStereoSplit", bStereoSplit);
+            v->write("bSingleBand", bSingleBand);
             v->write("nEnvBoost", nEnvBoost);
-            v->begin_array("vChannels", vChannels, channels);
+            v->write("nOversampling", nOversampling);
+            v->write("bAdaptiveRate", bAdaptiveRate);
+            v->write("nXOverLatency", nXOverLatency);
+            v->begin_array("vChannels", vChannels, nChannels);
             {
-                for (size_t i=0; i<channels; ++i)
+                for (size_t i=0; i<nChannels; ++i)
                 {
                     const channel_t *c = &vChannels[i];
 
@@ -2183,6 +2859,12 @@ namespace lsp
                             v->write("vSc", b->vSc);
                             v->write("vTr", b->vTr);
                             v->write("vVCA", b->vVCA);
+                            v->begin_array("sOver", b->sOver, 2);
+                            {
+                                for (size_t k=0; k<2; ++k)
+                                    v->write_object(&b->sOver[k]);
+                            }
+                            v->end_array();
                             v->write("fScPreamp", b->fScPreamp);
 
                             v->write("fFreqStart", b->fFreqStart);
@@ -2192,7 +2874,19 @@ namespace lsp
                             v->write("fFreqLCF", b->fFreqLCF);
                             v->write("fMakeup", b->fMakeup);
                             v->write("fGainLevel", b->fGainLevel);
+                            v->write("fEnvLevel", b->fEnvLevel);
+                            v->write("fCurveLevel", b->fCurveLevel);
+                            v->write("fReduction", b->fReduction);
                             v->write("nLookahead", b->nLookahead);
+                            v->write("fCtlPeak", b->fCtlPeak);
+                            v->write("fCtlFrom", b->fCtlFrom);
+                            v->write("fCtlTo", b->fCtlTo);
+                            v->write("nCtlPeriod", b->nCtlPeriod);
+                            v->write("nCtlPhase", b->nCtlPhase);
+                        #ifdef MB_COMPRESSOR_PROFILING
+                            dump_stage_time(v, "sScTime", &b->sScTime);
+                            dump_stage_time(v, "sCompTime", &b->sCompTime);
+                        #endif /* MB_COMPRESSOR_PROFILING */
 
                             v->write("bEnabled", b->bEnabled);
                             v->write("bCustHCF", b->bCustHCF);
@@ -2202,6 +2896,7 @@ namespace lsp
                             v->write("nScType", b->nScType);
                             v->write("nSync", b->nSync);
                             v->write("nFilterID", b->nFilterID);
+                            v->write("pDetector", b->pDetector);
 
                             v->write("pScType", b->pScType);
                             v->write("pScSource", b->pScSource);
@@ -2256,18 +2951,27 @@ namespace lsp
                     v->end_array();
                     v->writev("vPlan", c->vPlan, meta::mb_compressor_metadata::BANDS_MAX);
                     v->write("nPlanSize", c->nPlanSize);
+                    v->write("nXOverRank", c->nXOverRank);
 
                     v->write("vIn", c->vIn);
+                    v->write("vInData", c->vInData);
                     v->write("vOut", c->vOut);
                     v->write("vScIn", c->vScIn);
                     v->write("vShmIn", c->vShmIn);
+                    v->write("vShmGainOut", c->vShmGainOut);
+                    v->write("vShmGainIn", c->vShmGainIn);
+                    v->write("vShmProcIn", c->vShmProcIn);
+                    v->write("vShmProcOut", c->vShmProcOut);
 
                     v->write("vInAnalyze", c->vInAnalyze);
+                    v->write("vAnBuffer", c->vAnBuffer);
                     v->write("vInBuffer", c->vInBuffer);
+                    v->write("vInDelayed", c->vInDelayed);
                     v->write("vBuffer", c->vBuffer);
                     v->write("vScBuffer", c->vScBuffer);
                     v->write("vExtScBuffer", c->vExtScBuffer);
                     v->write("vShmBuffer", c->vShmBuffer);
+                    v->write("vShmLink", c->vShmLink);
                     v->write("vTr", c->vTr);
                     v->write("vTrMem", c->vTrMem);
 
@@ -2275,11 +2979,17 @@ namespace lsp
                     v->write("nAnOutChannel", c->nAnOutChannel);
                     v->write("bInFft", c->bInFft);
                     v->write("bOutFft", c->bOutFft);
+                    v->write("bXOver", c->bXOver);
+                    v->write("nSync", c->nSync);
 
                     v->write("pIn", c->pIn);
                     v->write("pOut", c->pOut);
                     v->write("pScIn", c->pScIn);
                     v->write("pShmIn", c->pShmIn);
+                    v->write("pShmGainOut", c->pShmGainOut);
+                    v->write("pShmGainIn", c->pShmGainIn);
+                    v->write("pShmProcOut", c->pShmProcOut);
+                    v->write("pShmProcIn", c->pShmProcIn);
                     v->write("pFftIn", c->pFftIn);
                     v->write("pFftInSw", c->pFftInSw);
                     v->write("pFftOut", c->pFftOut);
@@ -2299,6 +3009,9 @@ namespace lsp
             v->writev("vAnalyze", vAnalyze, 4);
             v->write("vBuffer", vBuffer);
             v->write("vEnv", vEnv);
+            v->write("vZero", vZero);
+            v->writev("vOvsSc", vOvsSc, 2);
+            v->write("vOvsEnv", vOvsEnv);
             v->write("vTr", vTr);
             v->write("vPFc", vPFc);
             v->write("vRFc", vRFc);
@@ -2306,6 +3019,10 @@ namespace lsp
             v->write("vCurve", vCurve);
             v->write("vIndexes", vIndexes);
             v->write("pIDisplay", pIDisplay);
+            v->write("vIDisplayIdx", vIDisplayIdx);
+            v->write("nIDisplayWidth", nIDisplayWidth);
+            v->write("bIDisplayUpdate", bIDisplayUpdate);
+            v->write("bIDisplayBypass", bIDisplayBypass);
 
             v->begin_object("sPremix", &sPremix, sizeof(premix_t));
             {
@@ -2321,8 +3038,6 @@ namespace lsp
                 v->writev("vSc", sPremix.vSc, 2);
                 v->writev("vLink", sPremix.vLink, 2);
                 v->writev("vTmpIn", sPremix.vTmpIn, 2);
-                v->writev("vTmpLink", sPremix.vTmpLink, 2);
-                v->writev("vTmpSc", sPremix.vTmpSc, 2);
 
                 v->write("pInToSc", sPremix.pInToSc);
                 v->write("pInToLink", sPremix.pInToLink);
@@ -2333,6 +3048,21 @@ namespace lsp
             }
             v->end_object();
 
+        #ifdef MB_COMPRESSOR_PROFILING
+            v->begin_object("vStageTime", vStageTime, sizeof(vStageTime));
+            {
+                dump_stage_time(v, "premix", &vStageTime[PS_PREMIX]);
+                dump_stage_time(v, "preprocess", &vStageTime[PS_PREPROCESS]);
+                dump_stage_time(v, "xover", &vStageTime[PS_XOVER]);
+                dump_stage_time(v, "analyzer", &vStageTime[PS_ANALYZER]);
+                dump_stage_time(v, "metering", &vStageTime[PS_METERING]);
+                dump_stage_time(v, "bypass", &vStageTime[PS_BYPASS]);
+                dump_stage_time(v, "mesh", &vStageTime[PS_MESH]);
+            }
+            v->end_object();
+        #endif /* MB_COMPRESSOR_PROFILING */
+
+            v->write("pGainLinkBand", pGainLinkBand);
             v->write("pBypass", pBypass);
             v->write("pMode", pMode);
             v->write("pInGain", pInGain);
@@ -2344,6 +3074,9 @@ namespace lsp
             v->write("pShiftGain", pShiftGain);
             v->write("pZoom", pZoom);
             v->write("pEnvBoost", pEnvBoost);
+            v->write("pOversampling", pOversampling);
+            v->write("pAdaptiveRate", pAdaptiveRate);
+            v->write("pXOverLatency", pXOverLatency);
             v->write("pStereoSplit", pStereoSplit);
         }
     } /* namespace plugins */
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mb-compressor
+ * Created on: 19 окт. 2026 г.
+ *
+ * lsp-plugins-mb-compressor is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mb-compressor is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mb-compressor. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/FloatBuffer.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include <private/meta/mb_compressor.h>
+#include <private/plugins/mb_compressor.h>
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr size_t SAMPLE_RATE     = 48000;
+    static constexpr size_t SAMPLES         = 24000;
+
+    /**
+     * Port that stores the value and refers the buffer provided by the test
+     */
+    class TestPort: public plug::IPort
+    {
+        private:
+            float       fValue;
+            void       *pBuffer;
+
+        public:
+            explicit TestPort(const meta::port_t *meta): plug::IPort(meta)
+            {
+                fValue      = meta->start;
+                pBuffer     = NULL;
+            }
+
+        public:
+            virtual float value() override          { return fValue;    }
+            virtual void set_value(float value) override { fValue = value; }
+            virtual void *buffer() override         { return pBuffer;   }
+
+        public:
+            void set_buffer(void *buffer)           { pBuffer = buffer; }
+    };
+
+    typedef struct instance_t
+    {
+        plugins::mb_compressor *pPlugin;
+        plug::IPort           **vPorts;
+        size_t                  nPorts;
+        size_t                  nChannels;
+    } instance_t;
+
+    typedef struct config_t
+    {
+        const char             *label;
+        float                   fMode;              // Crossover mode
+        float                   fOversampling;      // Detector oversampling
+        float                   fAdaptiveRate;      // Adaptive control rate
+        float                   fDryGain;           // Dry gain
+    } config_t;
+
+    static const config_t configs[] =
+    {
+        { "classic",                    0.0f, 0.0f, 0.0f, 0.0f },
+        { "modern",                     1.0f, 0.0f, 0.0f, 0.0f },
+        { "linear phase",               2.0f, 0.0f, 0.0f, 0.0f },
+        { "modern 4x oversampling",     1.0f, 2.0f, 0.0f, 0.0f },
+        { "modern adaptive rate",       1.0f, 0.0f, 1.0f, 0.0f },
+        { "classic 2x adaptive dry",    0.0f, 1.0f, 1.0f, 0.5f },
+        { NULL, 0.0f, 0.0f, 0.0f, 0.0f }
+    };
+
+    static const size_t block_sizes[] = { 1, 13, 256, 100, 1024, 4097, 33, 8192, 7 };
+}
+
+UTEST_BEGIN("plugins.dynamics", mb_compressor)
+
+    void create(instance_t *inst, const meta::plugin_t *meta, size_t mode)
+    {
+        inst->nPorts        = 0;
+        for (const meta::port_t *p = meta->ports; p->id != NULL; ++p)
+            ++inst->nPorts;
+        inst->nChannels     = (mode == plugins::mb_compressor::MBCM_MONO) ? 1 : 2;
+
+        inst->vPorts        = new plug::IPort *[inst->nPorts];
+        UTEST_ASSERT(inst->vPorts != NULL);
+        for (size_t i=0; i<inst->nPorts; ++i)
+            inst->vPorts[i]     = new TestPort(&meta->ports[i]);
+
+        inst->pPlugin       = new plugins::mb_compressor(meta, true, mode);
+        UTEST_ASSERT(inst->pPlugin != NULL);
+        inst->pPlugin->init(NULL, inst->vPorts);
+        inst->pPlugin->set_sample_rate(SAMPLE_RATE);
+    }
+
+    void destroy(instance_t *inst)
+    {
+        if (inst->pPlugin != NULL)
+        {
+            inst->pPlugin->destroy();
+            delete inst->pPlugin;
+            inst->pPlugin       = NULL;
+        }
+
+        if (inst->vPorts != NULL)
+        {
+            for (size_t i=0; i<inst->nPorts; ++i)
+                delete inst->vPorts[i];
+            delete [] inst->vPorts;
+            inst->vPorts        = NULL;
+        }
+    }
+
+    TestPort *find_port(instance_t *inst, const char *id)
+    {
+        for (size_t i=0; i<inst->nPorts; ++i)
+            if (!strcmp(inst->vPorts[i]->metadata()->id, id))
+                return static_cast<TestPort *>(inst->vPorts[i]);
+        return NULL;
+    }
+
+    void set_ports(instance_t *inst, const char *prefix, float value)
+    {
+        // Set the port and all its per-band and per-channel siblings named as prefix_*
+        const size_t len    = strlen(prefix);
+        for (size_t i=0; i<inst->nPorts; ++i)
+        {
+            const char *id      = inst->vPorts[i]->metadata()->id;
+            if ((strncmp(id, prefix, len) == 0) && ((id[len] == '\0') || (id[len] == '_')))
+                inst->vPorts[i]->set_value(value);
+        }
+    }
+
+    void configure(instance_t *inst, const config_t *cfg)
+    {
+        set_ports(inst, "mode", cfg->fMode);
+        set_ports(inst, "dovs", cfg->fOversampling);
+        set_ports(inst, "acr", cfg->fAdaptiveRate);
+        set_ports(inst, "g_dry", cfg->fDryGain);
+
+        // Make the compressors of all bands work hard
+        set_ports(inst, "cbe", 1.0f);
+        set_ports(inst, "al", GAIN_AMP_M_24_DB);
+        set_ports(inst, "at", 2.0f);
+        set_ports(inst, "rt", 40.0f);
+        set_ports(inst, "cr", 8.0f);
+        set_ports(inst, "sla", 1.0f);
+
+        inst->pPlugin->update_settings();
+    }
+
+    void bind_audio(instance_t *inst, const char *id, size_t channel, float *buf)
+    {
+        static const char * const suffix[] = { "_l", "_r" };
+
+        char name[32];
+        if (inst->nChannels > 1)
+            snprintf(name, sizeof(name), "%s%s", id, suffix[channel]);
+        else
+            snprintf(name, sizeof(name), "%s", id);
+
+        TestPort *p = find_port(inst, name);
+        UTEST_ASSERT_MSG(p != NULL, "Port '%s' not found", name);
+        p->set_buffer(buf);
+    }
+
+    void process(instance_t *inst, test::FloatBuffer **out, test::FloatBuffer **in, test::FloatBuffer **sc, bool split)
+    {
+        for (size_t offset=0, k=0; offset < SAMPLES; ++k)
+        {
+            const size_t to_do  = (split) ?
+                lsp_min(block_sizes[k % (sizeof(block_sizes)/sizeof(size_t))], SAMPLES - offset) :
+                SAMPLES - offset;
+
+            for (size_t i=0; i<inst->nChannels; ++i)
+            {
+                bind_audio(inst, "in", i, in[i]->data() + offset);
+                bind_audio(inst, "sc", i, sc[i]->data() + offset);
+                bind_audio(inst, "out", i, out[i]->data() + offset);
+            }
+
+            inst->pPlugin->process(to_do);
+            offset             += to_do;
+        }
+    }
+
+    void init_signal(test::FloatBuffer *buf, float freq, float gain)
+    {
+        // Noise with the slow amplitude modulation so detectors attack and release
+        buf->randomize_sign();
+        float *dst      = buf->data();
+        for (size_t i=0; i<SAMPLES; ++i)
+        {
+            const float t   = float(i) / float(SAMPLE_RATE);
+            dst[i]          = gain * (0.5f * dst[i] + sinf(2.0f * M_PI * 440.0f * t)) * (0.55f + 0.45f * sinf(2.0f * M_PI * freq * t));
+        }
+    }
+
+    void compare(const char *label, test::FloatBuffer **a, test::FloatBuffer **b, size_t channels, float tolerance)
+    {
+        for (size_t i=0; i<channels; ++i)
+        {
+            UTEST_ASSERT_MSG(a[i]->valid(), "Output buffer A of channel %d corrupted for '%s'", int(i), label);
+            UTEST_ASSERT_MSG(b[i]->valid(), "Output buffer B of channel %d corrupted for '%s'", int(i), label);
+            if (!a[i]->equals_adaptive(*b[i], tolerance))
+            {
+                a[i]->dump("a");
+                b[i]->dump("b");
+                UTEST_FAIL_MSG("Output of channel %d differs at sample %d for '%s'",
+                    int(i), int(a[i]->last_diff()), label);
+            }
+        }
+    }
+
+    void test_block_size(const meta::plugin_t *meta, size_t mode)
+    {
+        test::FloatBuffer *in[2], *sc[2], *out1[2], *out2[2];
+        for (size_t i=0; i<2; ++i)
+        {
+            in[i]       = new test::FloatBuffer(SAMPLES);
+            sc[i]       = new test::FloatBuffer(SAMPLES);
+            out1[i]     = new test::FloatBuffer(SAMPLES);
+            out2[i]     = new test::FloatBuffer(SAMPLES);
+            init_signal(in[i], 3.0f + i, GAIN_AMP_0_DB);
+            init_signal(sc[i], 5.0f + i, GAIN_AMP_M_6_DB);
+        }
+
+        for (const config_t *cfg = configs; cfg->label != NULL; ++cfg)
+        {
+            printf("Testing block size independence of %s for '%s'...\n", meta->uid, cfg->label);
+
+            instance_t a, b;
+            create(&a, meta, mode);
+            create(&b, meta, mode);
+            configure(&a, cfg);
+            configure(&b, cfg);
+
+            // The output must not depend on the size of blocks passed by the host
+            process(&a, out1, in, sc, false);
+            process(&b, out2, in, sc, true);
+            compare(cfg->label, out1, out2, a.nChannels, 1e-5f);
+
+            destroy(&a);
+            destroy(&b);
+        }
+
+        for (size_t i=0; i<2; ++i)
+        {
+            delete in[i];
+            delete sc[i];
+            delete out1[i];
+            delete out2[i];
+        }
+    }
+
+    void test_premix(const meta::plugin_t *meta, size_t mode)
+    {
+        test::FloatBuffer *in[2], *mixed[2], *sc[2], *out1[2], *out2[2];
+        const float sc_to_in    = GAIN_AMP_M_6_DB;
+
+        for (size_t i=0; i<2; ++i)
+        {
+            in[i]       = new test::FloatBuffer(SAMPLES);
+            mixed[i]    = new test::FloatBuffer(SAMPLES);
+            sc[i]       = new test::FloatBuffer(SAMPLES);
+            out1[i]     = new test::FloatBuffer(SAMPLES);
+            out2[i]     = new test::FloatBuffer(SAMPLES);
+            init_signal(in[i], 3.0f + i, GAIN_AMP_0_DB);
+            init_signal(sc[i], 5.0f + i, GAIN_AMP_M_6_DB);
+
+            // Reference pre-mix: the sidechain is added to the input before the plugin
+            dsp::fmadd_k4(mixed[i]->data(), in[i]->data(), sc[i]->data(), sc_to_in, SAMPLES);
+        }
+
+        for (const config_t *cfg = configs; cfg->label != NULL; ++cfg)
+        {
+            printf("Testing pre-mix of %s for '%s'...\n", meta->uid, cfg->label);
+
+            instance_t a, b;
+            create(&a, meta, mode);
+            create(&b, meta, mode);
+            set_ports(&a, "sc2in", sc_to_in);
+            configure(&a, cfg);
+            configure(&b, cfg);
+
+            // Fused pre-mix of the plugin must match the input pre-mixed in advance
+            process(&a, out1, in, sc, true);
+            process(&b, out2, mixed, sc, true);
+            compare(cfg->label, out1, out2, a.nChannels, 1e-4f);
+
+            destroy(&a);
+            destroy(&b);
+        }
+
+        for (size_t i=0; i<2; ++i)
+        {
+            delete in[i];
+            delete mixed[i];
+            delete sc[i];
+            delete out1[i];
+            delete out2[i];
+        }
+    }
+
+    UTEST_MAIN
+    {
+        dsp::init();
+
+        test_block_size(&meta::sc_mb_compressor_mono, plugins::mb_compressor::MBCM_MONO);
+        test_block_size(&meta::sc_mb_compressor_stereo, plugins::mb_compressor::MBCM_STEREO);
+        test_block_size(&meta::sc_mb_compressor_ms, plugins::mb_compressor::MBCM_MS);
+
+        test_premix(&meta::sc_mb_compressor_mono, plugins::mb_compressor::MBCM_MONO);
+        test_premix(&meta::sc_mb_compressor_stereo, plugins::mb_compressor::MBCM_STEREO);
+        test_premix(&meta::sc_mb_compressor_lr, plugins::mb_compressor::MBCM_LR);
+    }
+
+UTEST_END
+